@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/string.h>
+#include <frozen/unordered_set.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Random member keys looked up in the default two level tables, which branch
+// on the kind of first level slot, and in the tables of branchless_hash,
+// which always hash twice. Lookups are either independent, or each key
+// depends on the result of the previous lookup, to measure latency. With a
+// benchmark library built with libpfm, --benchmark_perf_counters=BRANCH-MISSES
+// also counts the mispredictions.
+
+struct TwoLevels : frozen::elsa<unsigned> {};
+using Branchless = frozen::branchless_hash<frozen::elsa<unsigned>>;
+struct StrTwoLevels : frozen::elsa<frozen::string> {};
+using StrBranchless = frozen::branchless_hash<frozen::elsa<frozen::string>>;
+
+static constexpr unsigned Ids[100] = {
+  695425565, 2035525363, 323946140, 847877000, 1397871145, 103694313, 155555738, 1763673107,
+  1150797846, 202142729, 785310973, 1251527727, 124551739, 1953574603, 1089709947, 461060839,
+  80521325, 184570286, 931247022, 898017870, 150013384, 516819859, 194804717, 1183364968,
+  911648020, 126938844, 1775651416, 1214302568, 265862674, 2034632751, 479402029, 1354258845,
+  1347402587, 1251976313, 2035189461, 132847737, 1239319144, 1257440635, 851864843, 106492239,
+  2096491879, 474769609, 100035545, 1195428768, 1843546982, 285990743, 621931212, 900094242,
+  309785427, 1161114103, 252956897, 1226027821, 662459677, 1203143341, 1752618008, 1464589643,
+  388106950, 221310450, 1248976841, 1226652085, 1372056228, 403449955, 799717634, 209230570,
+  1176272277, 1529246226, 134838300, 1211971682, 127992539, 1329312985, 442292976, 1066042003,
+  1461147819, 1141860530, 918247488, 1669086093, 674625912, 999872393, 1257484521, 1983075268,
+  973206041, 776492205, 643744727, 533492028, 1705916948, 386046158, 1501079115, 1674671377,
+  524193278, 175782304, 1233565528, 644780075, 1127850897, 1063254276, 1879343460, 737608423,
+  1566471825, 963864094, 618341637, 1307729535
+};
+
+static constexpr frozen::string Keywords[] = {
+  "auto",     "break",  "case",    "char",   "const",    "continue",
+  "default",  "do",     "double",  "else",   "enum",     "extern",
+  "float",    "for",    "goto",    "if",     "int",      "long",
+  "register", "return", "short",   "signed", "sizeof",   "static",
+  "struct",   "switch", "typedef", "union",  "unsigned", "void",
+  "volatile", "while"};
+
+static constexpr frozen::unordered_set<unsigned, 100, TwoLevels> IdsTwoLevels{Ids, TwoLevels{}, {}};
+static constexpr frozen::unordered_set<unsigned, 100, Branchless> IdsBranchless{Ids, Branchless{}, {}};
+static constexpr frozen::unordered_set<frozen::string, 32, StrTwoLevels> KeywordsTwoLevels{Keywords, StrTwoLevels{}, {}};
+static constexpr frozen::unordered_set<frozen::string, 32, StrBranchless> KeywordsBranchless{Keywords, StrBranchless{}, {}};
+
+// 4096 member keys in random order.
+template <class Key, std::size_t N>
+static std::vector<Key> RandomKeys(Key const (&keys)[N]) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<std::size_t> pick{0, N - 1};
+  std::vector<Key> random;
+  for (std::size_t i = 0; i < 4096; ++i)
+    random.push_back(keys[pick(generator)]);
+  return random;
+}
+
+template <class Set, class Key, std::size_t N>
+static void Throughput(benchmark::State &state, Set const &set, Key const (&keys)[N]) {
+  auto const random = RandomKeys(keys);
+  for (auto _ : state) {
+    for (auto const &key : random) {
+      volatile bool status = set.count(key);
+      benchmark::DoNotOptimize(status);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(random.size()));
+}
+
+// The next key is picked by the index of the one found.
+template <class Set, class Key, std::size_t N>
+static void Latency(benchmark::State &state, Set const &set, Key const (&keys)[N]) {
+  auto const random = RandomKeys(keys);
+  for (auto _ : state) {
+    std::size_t index = 0;
+    for (std::size_t i = 0; i < random.size(); ++i)
+      index = set.index_of(random[(i + index) % random.size()]);
+    benchmark::DoNotOptimize(index);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(random.size()));
+}
+
+static void BM_IntTwoLevelsThroughput(benchmark::State &state) { Throughput(state, IdsTwoLevels, Ids); }
+BENCHMARK(BM_IntTwoLevelsThroughput);
+static void BM_IntBranchlessThroughput(benchmark::State &state) { Throughput(state, IdsBranchless, Ids); }
+BENCHMARK(BM_IntBranchlessThroughput);
+static void BM_IntTwoLevelsLatency(benchmark::State &state) { Latency(state, IdsTwoLevels, Ids); }
+BENCHMARK(BM_IntTwoLevelsLatency);
+static void BM_IntBranchlessLatency(benchmark::State &state) { Latency(state, IdsBranchless, Ids); }
+BENCHMARK(BM_IntBranchlessLatency);
+
+static void BM_StrTwoLevelsThroughput(benchmark::State &state) { Throughput(state, KeywordsTwoLevels, Keywords); }
+BENCHMARK(BM_StrTwoLevelsThroughput);
+static void BM_StrBranchlessThroughput(benchmark::State &state) { Throughput(state, KeywordsBranchless, Keywords); }
+BENCHMARK(BM_StrBranchlessThroughput);
+static void BM_StrTwoLevelsLatency(benchmark::State &state) { Latency(state, KeywordsTwoLevels, Keywords); }
+BENCHMARK(BM_StrTwoLevelsLatency);
+static void BM_StrBranchlessLatency(benchmark::State &state) { Latency(state, KeywordsBranchless, Keywords); }
+BENCHMARK(BM_StrBranchlessLatency);
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/bulk_lookup.h>
+#include <frozen/dynamic_unordered_map.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// A dimension table of 1M keys, joined against a column of 4M keys, half of
+// which are in the table.
+static frozen::dynamic_unordered_map<std::uint64_t, std::uint32_t> const& Table() {
+  static frozen::dynamic_unordered_map<std::uint64_t, std::uint32_t> const table = [] {
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> items;
+    for (std::uint32_t i = 0; i < (1 << 20); ++i)
+      items.emplace_back(std::uint64_t(i) * 0x9E3779B97F4A7C15u, i);
+    return frozen::dynamic_unordered_map<std::uint64_t, std::uint32_t>(items.begin(), items.end(),
+                                                                       frozen::parallel_build{});
+  }();
+  return table;
+}
+
+static std::vector<std::uint64_t> const& Column() {
+  static std::vector<std::uint64_t> const column = [] {
+    std::vector<std::uint64_t> keys;
+    std::uint32_t state = 1;
+    for (std::size_t i = 0; i < (std::size_t(1) << 22); ++i) {
+      state = state * 1103515245u + 12345u;
+      keys.push_back(std::uint64_t(state >> 11) * 0x9E3779B97F4A7C15u);
+    }
+    return keys;
+  }();
+  return column;
+}
+
+static void BM_FindPerKey(benchmark::State& state) {
+  auto const& table = Table();
+  auto const& column = Column();
+  std::vector<std::uint32_t> values(column.size());
+  std::vector<char> found(column.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < column.size(); ++i) {
+      auto const where = table.find(column[i]);
+      found[i] = where != table.end();
+      values[i] = found[i] ? where->second : 0;
+    }
+    benchmark::DoNotOptimize(values.data());
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(column.size()));
+}
+
+static void BM_BulkLookup(benchmark::State& state) {
+  auto const& table = Table();
+  auto const& column = Column();
+  unsigned const threads = static_cast<unsigned>(state.range(0));
+  std::vector<std::uint32_t> values(column.size());
+  std::vector<char> found(column.size());
+  for (auto _ : state) {
+    frozen::bulk_lookup(table, column.begin(), column.end(), values.begin(), found.begin(), threads);
+    benchmark::DoNotOptimize(values.data());
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(column.size()));
+}
+
+static void ThreadCounts(benchmark::internal::Benchmark* bench) {
+  unsigned const max_threads = std::thread::hardware_concurrency();
+  for (unsigned threads = 1; threads < max_threads; threads *= 2)
+    bench->Arg(threads);
+  bench->Arg(max_threads ? max_threads : 1);
+}
+
+BENCHMARK(BM_FindPerKey)->UseRealTime();
+BENCHMARK(BM_BulkLookup)->Apply(ThreadCounts)->UseRealTime();
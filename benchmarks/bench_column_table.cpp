@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/column_table.h>
+#include <frozen/unordered_map.h>
+
+#include <array>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+// Reads one attribute of many keys, either from an unordered_map whose values
+// hold all the attributes of a key, or from the matching column of a
+// column_table. Tables are too large for the first level cache.
+
+static constexpr std::size_t Size = 1024;
+
+struct Record {
+  unsigned price;
+  unsigned stock;
+  double weight;
+  double width;
+  double height;
+  double depth;
+  char name[88];
+};
+
+using RecordMap = frozen::unordered_map<unsigned, Record, Size>;
+using RecordColumns = frozen::column_table<unsigned, Size, unsigned, unsigned, double, double, double, double>;
+
+static unsigned Id(std::size_t i) { return static_cast<unsigned>(i * 2654435761u); }
+
+static RecordMap const &Map() {
+  static auto const map = [] {
+    auto items = std::make_unique<std::array<std::pair<unsigned, Record>, Size>>();
+    for (std::size_t i = 0; i < Size; ++i)
+      (*items)[i] = {Id(i), Record{unsigned(i), unsigned(i % 7), 1., 2., 3., 4., "item"}};
+    return std::make_unique<RecordMap>(frozen::bits::carray<std::pair<const unsigned, Record>, Size>(*items));
+  }();
+  return *map;
+}
+
+static RecordColumns const &Columns() {
+  static auto const columns = [] {
+    auto rows = std::make_unique<std::array<RecordColumns::row_type, Size>>();
+    for (std::size_t i = 0; i < Size; ++i)
+      (*rows)[i] = RecordColumns::row_type{Id(i), unsigned(i), unsigned(i % 7), 1., 2., 3., 4.};
+    return std::make_unique<RecordColumns>(frozen::bits::carray<RecordColumns::row_type, Size>(*rows));
+  }();
+  return *columns;
+}
+
+static std::array<unsigned, Size> const &Keys() {
+  static auto const keys = [] {
+    std::array<unsigned, Size> ids;
+    for (std::size_t i = 0; i < Size; ++i)
+      ids[i] = Id((i * 769) % Size);
+    return ids;
+  }();
+  return keys;
+}
+
+static void BM_PriceInRecordMap(benchmark::State &state) {
+  auto const &map = Map();
+  auto const &keys = Keys();
+  for (auto _ : state) {
+    unsigned total = 0;
+    for (auto key : keys)
+      total += map.find(key)->second.price;
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(Size));
+}
+BENCHMARK(BM_PriceInRecordMap);
+
+static void BM_PriceInColumnTable(benchmark::State &state) {
+  auto const &columns = Columns();
+  auto const &prices = columns.column<0>();
+  auto const &keys = Keys();
+  for (auto _ : state) {
+    unsigned total = 0;
+    for (auto key : keys)
+      total += prices[columns.index_of(key)];
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(Size));
+}
+BENCHMARK(BM_PriceInColumnTable);
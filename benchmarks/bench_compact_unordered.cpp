@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/compact_unordered_set.h>
+#include <frozen/dynamic_unordered_set.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+static std::vector<std::uint64_t> Keys(std::size_t count) {
+  std::vector<std::uint64_t> keys;
+  keys.reserve(count);
+  std::uint64_t state = 88172645463325252ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    keys.push_back(state);
+  }
+  return keys;
+}
+
+// Keys of the set in a random order, so that lookups do not walk the tables.
+static std::vector<std::uint64_t> Queries(std::vector<std::uint64_t> const& keys) {
+  std::vector<std::uint64_t> queries(keys);
+  std::uint64_t state = 0x9E3779B97F4A7C15ull;
+  for (std::size_t i = queries.size(); i > 1; --i) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    std::swap(queries[i - 1], queries[(state >> 33) % i]);
+  }
+  return queries;
+}
+
+using FzDynamicSet = frozen::dynamic_unordered_set<std::uint64_t>;
+using FzCompactSet = frozen::compact_unordered_set<std::uint64_t>;
+
+static double TableBits(FzDynamicSet const& set) {
+  auto const& tables = frozen::bits::pmh_access::tables(set);
+  return 8. * (tables.first_table().size() * sizeof(tables.first_table()[0]) +
+               tables.second_table().size() * sizeof(tables.second_table()[0]));
+}
+
+static double TableBits(FzCompactSet const& set) {
+  return double(frozen::bits::pmh_access::tables(set).size_in_bits());
+}
+
+template <class Set>
+static Set const& CachedSet(std::size_t count) {
+  static std::map<std::size_t, std::unique_ptr<Set>> sets;
+  auto& set = sets[count];
+  if (!set) {
+    auto const keys = Keys(count);
+    set.reset(new Set(keys.begin(), keys.end()));
+  }
+  return *set;
+}
+
+template <class Set>
+static void LookupSet(benchmark::State& state) {
+  std::size_t const count = static_cast<std::size_t>(state.range(0));
+  auto const& set = CachedSet<Set>(count);
+  auto const queries = Queries(Keys(count));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(set.find(queries[i]));
+    i = i + 1 == count ? 0 : i + 1;
+  }
+  state.counters["bits_per_key"] = TableBits(set) / double(count);
+}
+
+template <class Set>
+static void BuildSet(benchmark::State& state) {
+  auto const keys = Keys(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    Set set(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(&set);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(LookupSet, FzDynamicSet)->RangeMultiplier(8)->Range(1 << 17, 1 << 23);
+BENCHMARK_TEMPLATE(LookupSet, FzCompactSet)->RangeMultiplier(8)->Range(1 << 17, 1 << 23);
+BENCHMARK_TEMPLATE(BuildSet, FzDynamicSet)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BuildSet, FzCompactSet)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/counter_map.h>
+#include <frozen/unordered_map.h>
+
+#include <atomic>
+#include <cstddef>
+
+// Baseline: atomic values stored next to their key, as in a mutable
+// frozen::unordered_map.
+static frozen::unordered_set<int, 8> const Keys{0, 1, 2, 3, 4, 5, 6, 7};
+static std::atomic<unsigned long> PackedCounters[8];
+
+static frozen::counter_map<int, unsigned long, 8> PaddedCounters{0, 1, 2, 3, 4, 5, 6, 7};
+static frozen::counter_map<int, unsigned long, 8, 16> ShardedCounters{0, 1, 2, 3, 4, 5, 6, 7};
+
+// Each thread counts its own key: only false sharing can slow it down.
+static void BM_PackedOwnKey(benchmark::State& state) {
+  int const key = state.thread_index() % 8;
+  for (auto _ : state)
+    PackedCounters[Keys.index_unchecked(key)].fetch_add(1, std::memory_order_relaxed);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PackedOwnKey)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_CounterMapOwnKey(benchmark::State& state) {
+  int const key = state.thread_index() % 8;
+  for (auto _ : state)
+    PaddedCounters.add(key);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CounterMapOwnKey)->ThreadRange(1, 8)->UseRealTime();
+
+// All threads count the same keys: true sharing, unless counters are sharded.
+static void BM_CounterMapSharedKeys(benchmark::State& state) {
+  int key = 0;
+  for (auto _ : state) {
+    PaddedCounters.add(key);
+    key = (key + 1) % 8;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CounterMapSharedKeys)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_ShardedCounterMapSharedKeys(benchmark::State& state) {
+  int key = 0;
+  for (auto _ : state) {
+    ShardedCounters.add(key);
+    key = (key + 1) % 8;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShardedCounterMapSharedKeys)->ThreadRange(1, 8)->UseRealTime();
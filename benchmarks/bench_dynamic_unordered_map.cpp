@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/dynamic_unordered_map.h>
+#include <frozen/unordered_map.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef FROZEN_BENCHMARK_HAS_ABSL
+#include <absl/container/flat_hash_map.h>
+#endif
+
+static std::vector<std::pair<std::uint64_t, std::uint64_t>> Items(std::size_t count) {
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> items;
+  items.reserve(count);
+  std::uint64_t state = 88172645463325252ull;
+  for (std::size_t i = 0; i < count; ++i) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    items.emplace_back(state, i);
+  }
+  return items;
+}
+
+template <class Map>
+static void BuildMap(benchmark::State& state) {
+  auto const items = Items(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    Map map(items.begin(), items.end());
+    benchmark::DoNotOptimize(&map);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+template <class Map>
+static void LookupMap(benchmark::State& state) {
+  auto const items = Items(static_cast<std::size_t>(state.range(0)));
+  Map const map(items.begin(), items.end());
+  for (auto _ : state) {
+    for (auto const& item : items) {
+      auto const where = map.find(item.first);
+      benchmark::DoNotOptimize(where);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+using FzDynamicMap = frozen::dynamic_unordered_map<std::uint64_t, std::uint64_t>;
+using StdMap = std::unordered_map<std::uint64_t, std::uint64_t>;
+
+BENCHMARK_TEMPLATE(BuildMap, FzDynamicMap)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK_TEMPLATE(BuildMap, StdMap)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK_TEMPLATE(LookupMap, FzDynamicMap)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK_TEMPLATE(LookupMap, StdMap)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+#ifdef FROZEN_BENCHMARK_HAS_ABSL
+using AbslMap = absl::flat_hash_map<std::uint64_t, std::uint64_t>;
+BENCHMARK_TEMPLATE(BuildMap, AbslMap)->RangeMultiplier(8)->Range(64, 1 << 18);
+BENCHMARK_TEMPLATE(LookupMap, AbslMap)->RangeMultiplier(8)->Range(64, 1 << 18);
+#endif
+
+// Same lookup engine, tables built at compile time vs. at runtime.
+static constexpr frozen::unordered_map<std::uint64_t, std::uint64_t, 32> Fixed{
+  {0, 0}, {2, 1}, {4, 2}, {6, 3}, {8, 4}, {10, 5}, {12, 6}, {14, 7},
+  {16, 8}, {18, 9}, {20, 10}, {22, 11}, {24, 12}, {26, 13}, {28, 14}, {30, 15},
+  {32, 16}, {34, 17}, {36, 18}, {38, 19}, {40, 20}, {42, 21}, {44, 22}, {46, 23},
+  {48, 24}, {50, 25}, {52, 26}, {54, 27}, {56, 28}, {58, 29}, {60, 30}, {62, 31}
+};
+static auto const* volatile SomeFixed = &Fixed;
+
+static void BM_IntInFzUnorderedMap(benchmark::State& state) {
+  for (auto _ : state) {
+    for (auto const& item : *SomeFixed) {
+      auto const where = Fixed.find(item.first);
+      benchmark::DoNotOptimize(where);
+    }
+  }
+}
+BENCHMARK(BM_IntInFzUnorderedMap);
+
+static void BM_IntInFzDynamicUnorderedMap(benchmark::State& state) {
+  FzDynamicMap const map(Fixed.begin(), Fixed.end());
+  for (auto _ : state) {
+    for (auto const& item : *SomeFixed) {
+      auto const where = map.find(item.first);
+      benchmark::DoNotOptimize(where);
+    }
+  }
+}
+BENCHMARK(BM_IntInFzDynamicUnorderedMap);
+
+// Multi-threaded build of a large table, in keys per second.
+static void BM_FzDynamicBuildThreads(benchmark::State& state) {
+  static auto const items = Items(std::size_t(1) << 22);
+  frozen::parallel_build const build{static_cast<unsigned>(state.range(0))};
+  for (auto _ : state) {
+    FzDynamicMap map(items.begin(), items.end(), build);
+    benchmark::DoNotOptimize(&map);
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(items.size()));
+}
+BENCHMARK(BM_FzDynamicBuildThreads)
+    ->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_FzDynamicLookupSharded(benchmark::State& state) {
+  static auto const items = Items(std::size_t(1) << 22);
+  static FzDynamicMap const map(items.begin(), items.end(), frozen::parallel_build{});
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < items.size(); i += 64) {
+      auto const where = map.find(items[i].first);
+      benchmark::DoNotOptimize(where);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(items.size() / 64));
+}
+BENCHMARK(BM_FzDynamicLookupSharded);
+
+// Reload of a large table after a handful of changes.
+static void BM_FzDynamicRebuild(benchmark::State& state) {
+  static auto const items = Items(std::size_t(1) << 20);
+  static FzDynamicMap const map(items.begin(), items.end(), frozen::parallel_build{});
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> added;
+  std::vector<std::uint64_t> erased;
+  for (std::size_t i = 0; i < 16; ++i) {
+    added.emplace_back(items[i * 4099].first + 1, i);
+    erased.push_back(items[i * 4099 + 1].first);
+  }
+  for (auto _ : state) {
+    auto rebuilt = map.rebuild(added.begin(), added.end(), erased.begin(), erased.end());
+    benchmark::DoNotOptimize(&rebuilt);
+  }
+}
+BENCHMARK(BM_FzDynamicRebuild)->Unit(benchmark::kMillisecond);
+
+static void BM_FzDynamicFullRebuild(benchmark::State& state) {
+  static auto const items = Items(std::size_t(1) << 20);
+  for (auto _ : state) {
+    FzDynamicMap map(items.begin(), items.end(), frozen::parallel_build{});
+    benchmark::DoNotOptimize(&map);
+  }
+}
+BENCHMARK(BM_FzDynamicFullRebuild)->Unit(benchmark::kMillisecond);
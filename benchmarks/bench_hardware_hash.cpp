@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/hardware_hash.h>
+#include <frozen/string.h>
+#include <frozen/unordered_set.h>
+
+#include <string>
+#include <vector>
+
+// Lookups in unordered sets hashed by elsa, crc_hash and aes_hash, on sparse
+// integers, that use the two level tables, and on short and long strings.
+
+static constexpr unsigned Ids[64] = {
+  1365180540, 1540383426, 304089172, 1303455736, 35005211, 521595368, 294702567, 1726956429,
+  336465782, 861021530, 278722862, 233665123, 2145174067, 468703135, 1101513929, 1801979802,
+  1315634022, 635723058, 1369133069, 1125898167, 1059961393, 2089018456, 628175011, 1656478042,
+  1131176229, 1653377373, 859484421, 1914544919, 608413784, 756898537, 1734575198, 1973594324,
+  149798315, 2038664370, 1129566413, 184803526, 412776091, 1424268980, 1911759956, 749241873,
+  137806862, 42999170, 982906996, 135497281, 511702305, 2084420925, 1937477084, 1827336327,
+  572660336, 1159126505, 805750846, 1632621729, 1100661313, 1433925857, 1141616124, 84353895,
+  939819582, 2001100545, 1998898814, 1548233367, 610515434, 1585990364, 1374344043, 760313750
+};
+
+static constexpr frozen::string Keywords[] = {
+    "auto",     "break",  "case",    "char",   "const",    "continue",
+    "default",  "do",     "double",  "else",   "enum",     "extern",
+    "float",    "for",    "goto",    "if",     "int",      "long",
+    "register", "return", "short",   "signed", "sizeof",   "static",
+    "struct",   "switch", "typedef", "union",  "unsigned", "void",
+    "volatile", "while"};
+
+static constexpr frozen::string Urls[] = {
+    "https://example.com/api/v1/users/profile/settings",
+    "https://example.com/api/v1/users/profile/avatar",
+    "https://example.com/api/v1/users/profile/emails",
+    "https://example.com/api/v1/orders/history/recent",
+    "https://example.com/api/v1/orders/history/archive",
+    "https://example.com/api/v1/orders/checkout/cart",
+    "https://example.com/api/v1/catalog/products/list",
+    "https://example.com/api/v1/catalog/products/search"};
+
+template <class Hash> struct TwoLevels : Hash {};
+
+template <class Hash>
+static void IntLookup(benchmark::State &state) {
+  static constexpr frozen::unordered_set<unsigned, 64, TwoLevels<Hash>> set{Ids, {}, {}};
+  auto const *volatile some = &Ids;
+  for (auto _ : state) {
+    for (auto id : *some) {
+      volatile bool status = set.count(id);
+      benchmark::DoNotOptimize(status);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * 64);
+}
+BENCHMARK_TEMPLATE(IntLookup, frozen::elsa<unsigned>);
+BENCHMARK_TEMPLATE(IntLookup, frozen::crc_hash<unsigned>);
+BENCHMARK_TEMPLATE(IntLookup, frozen::aes_hash<unsigned>);
+
+template <class Set, std::size_t N>
+static void StrLookup(benchmark::State &state, Set const &set, frozen::string const (&keys)[N]) {
+  std::vector<std::string> copies;
+  for (auto key : keys)
+    copies.emplace_back(key.data(), key.size());
+  for (auto _ : state) {
+    for (auto const &key : copies) {
+      volatile bool status = set.count(frozen::string(key.data(), key.size()));
+      benchmark::DoNotOptimize(status);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(N));
+}
+
+template <class Hash>
+static void KeywordLookup(benchmark::State &state) {
+  static constexpr frozen::unordered_set<frozen::string, 32, Hash> set{Keywords, {}, {}};
+  StrLookup(state, set, Keywords);
+}
+BENCHMARK_TEMPLATE(KeywordLookup, frozen::elsa<frozen::string>);
+BENCHMARK_TEMPLATE(KeywordLookup, frozen::crc_hash<frozen::string>);
+BENCHMARK_TEMPLATE(KeywordLookup, frozen::aes_hash<frozen::string>);
+
+template <class Hash>
+static void UrlLookup(benchmark::State &state) {
+  static constexpr frozen::unordered_set<frozen::string, 8, Hash> set{Urls, {}, {}};
+  StrLookup(state, set, Urls);
+}
+BENCHMARK_TEMPLATE(UrlLookup, frozen::elsa<frozen::string>);
+BENCHMARK_TEMPLATE(UrlLookup, frozen::crc_hash<frozen::string>);
+BENCHMARK_TEMPLATE(UrlLookup, frozen::aes_hash<frozen::string>);
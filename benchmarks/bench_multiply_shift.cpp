@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/unordered_set.h>
+
+#include <iterator>
+#include <unordered_set>
+
+// Integer keys looked up in the single level tables of frozen::unordered_set,
+// when a multiplier is found, and in the two level tables used otherwise,
+// forced by a custom hasher.
+
+struct TwoLevels : frozen::elsa<unsigned> {};
+
+static constexpr unsigned EnumLike[32] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+  16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+};
+
+static constexpr unsigned SparseIds[16] = {
+  1804289383, 846930886, 1681692777, 1714636915, 1957747793, 424238335, 719885386, 1649760492,
+  596516649, 1189641421, 1025202362, 1350490027, 783368690, 1102520059, 2044897763, 1967513926
+};
+
+static constexpr unsigned ManySparseIds[64] = {
+  1365180540, 1540383426, 304089172, 1303455736, 35005211, 521595368, 294702567, 1726956429,
+  336465782, 861021530, 278722862, 233665123, 2145174067, 468703135, 1101513929, 1801979802,
+  1315634022, 635723058, 1369133069, 1125898167, 1059961393, 2089018456, 628175011, 1656478042,
+  1131176229, 1653377373, 859484421, 1914544919, 608413784, 756898537, 1734575198, 1973594324,
+  149798315, 2038664370, 1129566413, 184803526, 412776091, 1424268980, 1911759956, 749241873,
+  137806862, 42999170, 982906996, 135497281, 511702305, 2084420925, 1937477084, 1827336327,
+  572660336, 1159126505, 805750846, 1632621729, 1100661313, 1433925857, 1141616124, 84353895,
+  939819582, 2001100545, 1998898814, 1548233367, 610515434, 1585990364, 1374344043, 760313750
+};
+
+static constexpr frozen::unordered_set<unsigned, 32> EnumLikeFz{EnumLike};
+static constexpr frozen::unordered_set<unsigned, 32, TwoLevels> EnumLikeTwoLevels{EnumLike, TwoLevels{}, {}};
+static const std::unordered_set<unsigned> EnumLikeStd(std::begin(EnumLike), std::end(EnumLike));
+
+static constexpr frozen::unordered_set<unsigned, 16> SparseFz{SparseIds};
+static constexpr frozen::unordered_set<unsigned, 16, TwoLevels> SparseTwoLevels{SparseIds, TwoLevels{}, {}};
+static const std::unordered_set<unsigned> SparseStd(std::begin(SparseIds), std::end(SparseIds));
+
+static constexpr frozen::unordered_set<unsigned, 64> ManySparseFz{ManySparseIds};
+static constexpr frozen::unordered_set<unsigned, 64, TwoLevels> ManySparseTwoLevels{ManySparseIds, TwoLevels{}, {}};
+static const std::unordered_set<unsigned> ManySparseStd(std::begin(ManySparseIds), std::end(ManySparseIds));
+
+template <class Table, std::size_t N>
+static void Lookup(benchmark::State &state, Table const &table, unsigned const (&keys)[N]) {
+  auto const *volatile some = &keys;
+  for (auto _ : state) {
+    for (auto key : *some) {
+      volatile bool status = table.count(key);
+      benchmark::DoNotOptimize(status);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(N));
+}
+
+static void BM_EnumLikeInFzSingleLevel(benchmark::State &state) { Lookup(state, EnumLikeFz, EnumLike); }
+BENCHMARK(BM_EnumLikeInFzSingleLevel);
+static void BM_EnumLikeInFzTwoLevels(benchmark::State &state) { Lookup(state, EnumLikeTwoLevels, EnumLike); }
+BENCHMARK(BM_EnumLikeInFzTwoLevels);
+static void BM_EnumLikeInStd(benchmark::State &state) { Lookup(state, EnumLikeStd, EnumLike); }
+BENCHMARK(BM_EnumLikeInStd);
+
+static void BM_SparseIdInFzSingleLevel(benchmark::State &state) { Lookup(state, SparseFz, SparseIds); }
+BENCHMARK(BM_SparseIdInFzSingleLevel);
+static void BM_SparseIdInFzTwoLevels(benchmark::State &state) { Lookup(state, SparseTwoLevels, SparseIds); }
+BENCHMARK(BM_SparseIdInFzTwoLevels);
+static void BM_SparseIdInStd(benchmark::State &state) { Lookup(state, SparseStd, SparseIds); }
+BENCHMARK(BM_SparseIdInStd);
+
+// Too many keys for a multiplier: both use two levels.
+static void BM_ManySparseIdInFz(benchmark::State &state) { Lookup(state, ManySparseFz, ManySparseIds); }
+BENCHMARK(BM_ManySparseIdInFz);
+static void BM_ManySparseIdInFzTwoLevels(benchmark::State &state) {
+  Lookup(state, ManySparseTwoLevels, ManySparseIds);
+}
+BENCHMARK(BM_ManySparseIdInFzTwoLevels);
+static void BM_ManySparseIdInStd(benchmark::State &state) { Lookup(state, ManySparseStd, ManySparseIds); }
+BENCHMARK(BM_ManySparseIdInStd);
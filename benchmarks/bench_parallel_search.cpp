@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include "frozen/parallel_search.h"
+
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string const& Haystack() {
+  static std::string const haystack = [] {
+    std::string text;
+    text.reserve(std::size_t(1) << 26);
+    unsigned state = 1;
+    while (text.size() < text.capacity() - 64) {
+      state = state * 1103515245u + 12345u;
+      if ((state >> 16) % 4096 == 0)
+        text += "The cold never bothered me anyway";
+      else
+        text += static_cast<char>(' ' + (state >> 8) % 95);
+    }
+    return text;
+  }();
+  return haystack;
+}
+
+static constexpr char Word[] = "bothered me";
+
+static void BM_StrFzParallelSearchBM(benchmark::State& state) {
+  auto const& haystack = Haystack();
+  auto const searcher = frozen::make_boyer_moore_searcher(Word);
+  unsigned const threads = static_cast<unsigned>(state.range(0));
+  std::vector<std::string::const_iterator> matches;
+  for (auto _ : state) {
+    matches.clear();
+    frozen::parallel_find_all(haystack.begin(), haystack.end(), searcher, std::back_inserter(matches), threads);
+    benchmark::DoNotOptimize(matches.data());
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(haystack.size()));
+}
+
+static void BM_StrFzParallelSearchKMP(benchmark::State& state) {
+  auto const& haystack = Haystack();
+  auto const searcher = frozen::make_knuth_morris_pratt_searcher(Word);
+  unsigned const threads = static_cast<unsigned>(state.range(0));
+  std::vector<std::string::const_iterator> matches;
+  for (auto _ : state) {
+    matches.clear();
+    frozen::parallel_find_all(haystack.begin(), haystack.end(), searcher, std::back_inserter(matches), threads);
+    benchmark::DoNotOptimize(matches.data());
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(haystack.size()));
+}
+
+static void ThreadCounts(benchmark::internal::Benchmark* bench) {
+  unsigned const max_threads = std::thread::hardware_concurrency();
+  for (unsigned threads = 1; threads < max_threads; threads *= 2)
+    bench->Arg(threads);
+  bench->Arg(max_threads ? max_threads : 1);
+}
+
+BENCHMARK(BM_StrFzParallelSearchBM)->Apply(ThreadCounts)->UseRealTime();
+BENCHMARK(BM_StrFzParallelSearchKMP)->Apply(ThreadCounts)->UseRealTime();
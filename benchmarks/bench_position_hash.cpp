@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/position_hash.h>
+#include <frozen/string.h>
+#include <frozen/unordered_set.h>
+
+#include <string>
+#include <vector>
+
+// Keyword sets hashed on every character (elsa, FNV-1a) or on their length
+// and a few selected characters (position_hash).
+
+static constexpr frozen::string CKeywords[] = {
+    "auto",     "break",  "case",    "char",   "const",    "continue",
+    "default",  "do",     "double",  "else",   "enum",     "extern",
+    "float",    "for",    "goto",    "if",     "int",      "long",
+    "register", "return", "short",   "signed", "sizeof",   "static",
+    "struct",   "switch", "typedef", "union",  "unsigned", "void",
+    "volatile", "while"};
+
+static constexpr frozen::string SqlKeywords[] = {
+    "SELECT", "FROM",   "WHERE",  "INSERT",   "INTO",  "VALUES", "UPDATE", "SET",     "DELETE",
+    "CREATE", "TABLE",  "DROP",   "ALTER",    "INDEX", "JOIN",   "INNER",  "LEFT",    "RIGHT",
+    "OUTER",  "ON",     "AND",    "OR",       "NOT",   "NULL",   "IS",     "IN",      "LIKE",
+    "BETWEEN", "GROUP", "BY",     "ORDER",    "HAVING", "LIMIT", "OFFSET", "UNION",   "ALL",
+    "DISTINCT", "AS",   "CASE",   "WHEN",     "THEN",  "ELSE",   "END",    "EXISTS"};
+
+static constexpr frozen::string HttpMethods[] = {
+    "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH"};
+
+template <std::size_t N>
+static std::vector<std::string> Copy(frozen::string const (&keys)[N]) {
+  std::vector<std::string> copy;
+  for (auto key : keys)
+    copy.emplace_back(key.data(), key.size());
+  return copy;
+}
+
+template <class Set>
+static void Lookup(benchmark::State &state, Set const &set, std::vector<std::string> const &keys) {
+  for (auto _ : state) {
+    for (auto const &key : keys) {
+      volatile bool status = set.count(frozen::string(key.data(), key.size()));
+      benchmark::DoNotOptimize(status);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(keys.size()));
+}
+
+static void BM_CKeywordsFnv(benchmark::State &state) {
+  static constexpr frozen::unordered_set<frozen::string, 32> set{CKeywords};
+  Lookup(state, set, Copy(CKeywords));
+}
+BENCHMARK(BM_CKeywordsFnv);
+
+static void BM_CKeywordsPositions(benchmark::State &state) {
+  static constexpr auto set = frozen::make_positional_unordered_set(CKeywords);
+  Lookup(state, set, Copy(CKeywords));
+}
+BENCHMARK(BM_CKeywordsPositions);
+
+static void BM_SqlKeywordsFnv(benchmark::State &state) {
+  static constexpr frozen::unordered_set<frozen::string, 44> set{SqlKeywords};
+  Lookup(state, set, Copy(SqlKeywords));
+}
+BENCHMARK(BM_SqlKeywordsFnv);
+
+static void BM_SqlKeywordsPositions(benchmark::State &state) {
+  static constexpr auto set = frozen::make_positional_unordered_set(SqlKeywords);
+  Lookup(state, set, Copy(SqlKeywords));
+}
+BENCHMARK(BM_SqlKeywordsPositions);
+
+static void BM_HttpMethodsFnv(benchmark::State &state) {
+  static constexpr frozen::unordered_set<frozen::string, 9> set{HttpMethods};
+  Lookup(state, set, Copy(HttpMethods));
+}
+BENCHMARK(BM_HttpMethodsFnv);
+
+static void BM_HttpMethodsPositions(benchmark::State &state) {
+  static constexpr auto set = frozen::make_positional_unordered_set(HttpMethods);
+  Lookup(state, set, Copy(HttpMethods));
+}
+BENCHMARK(BM_HttpMethodsPositions);
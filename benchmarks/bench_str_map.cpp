@@ -1,10 +1,14 @@
 #include <benchmark/benchmark.h>
 
+#include <frozen/fixed_string.h>
+#include <frozen/map.h>
+#include <frozen/overlay_map.h>
 #include <frozen/unordered_map.h>
 #include <frozen/string.h>
 
 #include <algorithm>
 #include <array>
+#include <cctype>
 #include <string>
 #include <unordered_map>
 
@@ -32,6 +36,61 @@ static void BM_StrInFzUnorderedMap(benchmark::State &state)
 }
 BENCHMARK(BM_StrInFzUnorderedMap);
 
+static void BM_StrInFzOverlayMap(benchmark::State &state)
+{
+  frozen::overlay_map<decltype(Keywords)> const overlay(Keywords);
+  for (auto _ : state)
+  {
+    for (auto kw : *Some)
+    {
+      volatile bool status = overlay.count(kw.first);
+      benchmark::DoNotOptimize(status);
+    }
+  }
+}
+BENCHMARK(BM_StrInFzOverlayMap);
+
+static void BM_StrInFzOverlayMapWithOverrides(benchmark::State &state)
+{
+  frozen::overlay_map<decltype(Keywords)> overlay(Keywords);
+  overlay.insert_or_assign("goto", "deprecated");
+  overlay.insert_or_assign("constexpr", "keyword");
+  for (auto _ : state)
+  {
+    for (auto kw : *Some)
+    {
+      volatile bool status = overlay.count(kw.first);
+      benchmark::DoNotOptimize(status);
+    }
+  }
+}
+BENCHMARK(BM_StrInFzOverlayMapWithOverrides);
+
+// Same keywords, stored inline as at most 8 characters.
+static constexpr frozen::unordered_map<frozen::fixed_string<8>, frozen::string, 32> FixedKeywords{
+    {"auto", "keyword"}, {"break", "keyword"}, {"case", "keyword"}, {"char", "keyword"}, {"const", "keyword"}, {"continue", "keyword"},
+    {"default", "keyword"}, {"do", "keyword"}, {"double", "keyword"}, {"else", "keyword"}, {"enum", "keyword"}, {"extern", "keyword"},
+    {"float", "keyword"}, {"for", "keyword"}, {"goto", "keyword"}, {"if", "keyword"}, {"int", "keyword"}, {"long", "keyword"},
+    {"register", "keyword"}, {"return", "keyword"}, {"short", "keyword"}, {"signed", "keyword"}, {"sizeof", "keyword"}, {"static", "keyword"},
+    {"struct", "keyword"}, {"switch", "keyword"}, {"typedef", "keyword"}, {"union", "keyword"}, {"unsigned", "keyword"},
+    {"void", "keyword"}, {"volatile", "keyword"}, {"while", "keyword"}
+};
+
+static auto const *volatile SomeFixed = &FixedKeywords;
+
+static void BM_StrInFzFixedUnorderedMap(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    for (auto kw : *SomeFixed)
+    {
+      volatile bool status = FixedKeywords.count(kw.first);
+      benchmark::DoNotOptimize(status);
+    }
+  }
+}
+BENCHMARK(BM_StrInFzFixedUnorderedMap);
+
 static const std::unordered_map<frozen::string, frozen::string> Keywords_(Keywords.begin(), Keywords.end());
 
 static void BM_StrInStdUnorderedMap(benchmark::State &state)
@@ -82,3 +141,135 @@ static void BM_StrNotInStdUnorderedMap(benchmark::State &state)
   }
 }
 BENCHMARK(BM_StrNotInStdUnorderedMap);
+
+// Long keys sharing a 49 character prefix, where comparisons dominate: each
+// binary search step of a frozen::map compares whole prefixes.
+static constexpr frozen::map<frozen::string, int, 32> LongKeys = frozen::make_map<frozen::string, int>({
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/auto.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/break.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/case.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/char.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/const.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/continue.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/default.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/do.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/double.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/else.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/enum.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/extern.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/float.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/for.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/goto.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/if.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/int.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/long.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/register.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/return.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/short.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/signed.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/sizeof.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/static.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/struct.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/switch.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/typedef.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/union.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/unsigned.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/void.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/volatile.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/while.h", 0}});
+
+static std::array<std::string, 32> const LongKeysCopy = [] {
+  std::array<std::string, 32> copy;
+  std::transform(LongKeys.begin(), LongKeys.end(), copy.begin(),
+                 [](std::pair<frozen::string, int> const &item) { return std::string(item.first.data(), item.first.size()); });
+  return copy;
+}();
+
+static void BM_LongStrInFzMap(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    for (auto const &kw : LongKeysCopy)
+    {
+      volatile bool status = LongKeys.count(frozen::string(kw.data(), kw.size()));
+      benchmark::DoNotOptimize(status);
+    }
+  }
+}
+BENCHMARK(BM_LongStrInFzMap);
+
+static void BM_LongStrInFzUnorderedMap(benchmark::State &state)
+{
+  static constexpr auto unordered = frozen::make_unordered_map<frozen::string, int>({
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/auto.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/break.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/case.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/char.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/const.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/continue.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/default.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/do.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/double.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/else.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/enum.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/extern.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/float.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/for.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/goto.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/if.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/int.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/long.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/register.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/return.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/short.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/signed.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/sizeof.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/static.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/struct.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/switch.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/typedef.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/union.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/unsigned.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/void.h", 0},
+    {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/volatile.h", 0}, {"/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/while.h", 0}});
+  for (auto _ : state)
+  {
+    for (auto const &kw : LongKeysCopy)
+    {
+      volatile bool status = unordered.count(frozen::string(kw.data(), kw.size()));
+      benchmark::DoNotOptimize(status);
+    }
+  }
+}
+BENCHMARK(BM_LongStrInFzUnorderedMap);
+
+// A lexer that looks each token of a C-like text up in the keyword table,
+// hashing the token again in find, or while scanning it with find_hashed.
+static constexpr frozen::unordered_map<frozen::string, frozen::string, 32, frozen::incremental_elsa<frozen::string>> HashedKeywords{
+    {"auto", "keyword"}, {"break", "keyword"}, {"case", "keyword"}, {"char", "keyword"}, {"const", "keyword"}, {"continue", "keyword"},
+    {"default", "keyword"}, {"do", "keyword"}, {"double", "keyword"}, {"else", "keyword"}, {"enum", "keyword"}, {"extern", "keyword"},
+    {"float", "keyword"}, {"for", "keyword"}, {"goto", "keyword"}, {"if", "keyword"}, {"int", "keyword"}, {"long", "keyword"},
+    {"register", "keyword"}, {"return", "keyword"}, {"short", "keyword"}, {"signed", "keyword"}, {"sizeof", "keyword"}, {"static", "keyword"},
+    {"struct", "keyword"}, {"switch", "keyword"}, {"typedef", "keyword"}, {"union", "keyword"}, {"unsigned", "keyword"},
+    {"void", "keyword"}, {"volatile", "keyword"}, {"while", "keyword"}
+};
+
+static std::string const &Source() {
+  static std::string const source = [] {
+    std::string text;
+    for (int i = 0; i < 1000; ++i)
+      text += "static unsigned long counter_value = 0; while (counter_value < limit) { if (flags) return counter_value; } ";
+    return text;
+  }();
+  return source;
+}
+
+template <class Table, class Lookup>
+static std::size_t CountKeywords(std::string const &source, Table const &table, Lookup const &lookup) {
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < source.size();) {
+    if (!std::isalpha(static_cast<unsigned char>(source[i])) && source[i] != '_') {
+      ++i;
+      continue;
+    }
+    frozen::basic_string_hash_state<char> state;
+    std::size_t const start = i;
+    for (; i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_'); ++i)
+      state.update(source[i]);
+    count += lookup(table, frozen::string(source.data() + start, i - start), state) != table.end();
+  }
+  return count;
+}
+
+static void BM_TokenizeFind(benchmark::State &state)
+{
+  auto const &source = Source();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(CountKeywords(source, Keywords, [](decltype(Keywords) const &table, frozen::string token,
+                                                                frozen::basic_string_hash_state<char> const &) {
+      return table.find(token);
+    }));
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(source.size()));
+}
+BENCHMARK(BM_TokenizeFind);
+
+static void BM_TokenizeFindHashed(benchmark::State &state)
+{
+  auto const &source = Source();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(CountKeywords(source, HashedKeywords, [](decltype(HashedKeywords) const &table, frozen::string token,
+                                                                      frozen::basic_string_hash_state<char> const &hash) {
+      return table.find_hashed(token, hash.finish());
+    }));
+  state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(source.size()));
+}
+BENCHMARK(BM_TokenizeFindHashed);
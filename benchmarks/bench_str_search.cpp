@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <functional>
 #include <cstring>
+#include <string>
 
 static char const Words [] = R"(
 Let it go, let it go
@@ -58,6 +59,79 @@ static void BM_StrFzSearchInKMP(benchmark::State& state) {
 }
 BENCHMARK(BM_StrFzSearchInKMP);
 
+static char const * volatile RuntimeWordPtr = Word;
+
+static void BM_StrFzSearchInRuntimeBM(benchmark::State& state) {
+  frozen::runtime_boyer_moore_searcher<16> const searcher(RuntimeWordPtr, sizeof(Word) - 1);
+  for (auto _ : state) {
+    volatile bool status = frozen::search(std::begin(*WordsPtr), std::end(*WordsPtr), searcher);
+  }
+}
+BENCHMARK(BM_StrFzSearchInRuntimeBM);
+
+static void BM_StrFzSearchInRuntimeKMP(benchmark::State& state) {
+  frozen::runtime_knuth_morris_pratt_searcher<16> const searcher(RuntimeWordPtr, sizeof(Word) - 1);
+  for (auto _ : state) {
+    volatile bool status = frozen::search(std::begin(*WordsPtr), std::end(*WordsPtr), searcher);
+  }
+}
+BENCHMARK(BM_StrFzSearchInRuntimeKMP);
+
+static std::string const DenseText(1 << 16, 'a');
+static constexpr char DenseWord[] = "aaaaaaaaaaaaaaaa";
+
+static void BM_StrFzCountRestartBM(benchmark::State& state) {
+  auto const searcher = frozen::make_boyer_moore_searcher(DenseWord);
+  for (auto _ : state) {
+    std::size_t count = 0;
+    for (auto where = frozen::search(DenseText.begin(), DenseText.end(), searcher);
+         where != DenseText.end();
+         where = frozen::search(where + 1, DenseText.end(), searcher))
+      ++count;
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_StrFzCountRestartBM);
+
+static void BM_StrFzCountFindAllBM(benchmark::State& state) {
+  auto const searcher = frozen::make_boyer_moore_searcher(DenseWord);
+  for (auto _ : state) {
+    std::size_t count = frozen::find_all(DenseText.begin(), DenseText.end(), searcher).count();
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_StrFzCountFindAllBM);
+
+static void BM_StrFzCountFindAllKMP(benchmark::State& state) {
+  auto const searcher = frozen::make_knuth_morris_pratt_searcher(DenseWord);
+  for (auto _ : state) {
+    std::size_t count = frozen::find_all(DenseText.begin(), DenseText.end(), searcher).count();
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_StrFzCountFindAllKMP);
+
+static constexpr auto WordsIndex = frozen::make_suffix_array(Words);
+static frozen::string const * volatile WordPtr = nullptr;
+
+static void BM_StrFzCountSuffixArray(benchmark::State& state) {
+  static frozen::string const word = Word;
+  WordPtr = &word;
+  for (auto _ : state) {
+    std::size_t count = WordsIndex.count(*WordPtr);
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_StrFzCountSuffixArray);
+
+static void BM_StrFzCountFindAllInWordsBM(benchmark::State& state) {
+  for (auto _ : state) {
+    std::size_t count = frozen::find_all(std::begin(*WordsPtr), std::end(*WordsPtr), frozen::make_boyer_moore_searcher(Word)).count();
+    benchmark::DoNotOptimize(count);
+  }
+}
+BENCHMARK(BM_StrFzCountFindAllInWordsBM);
+
 #if 0
 static void BM_StrStdSearchInStrStr(benchmark::State& state) {
   for (auto _ : state) {
@@ -100,3 +100,52 @@ static void BM_StrNotInStdArray(benchmark::State& state) {
 }
 
 BENCHMARK(BM_StrNotInStdArray);
+
+// Long keys sharing a 49 character prefix, where comparisons dominate.
+static constexpr frozen::set<frozen::string, 32> LongKeys{
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/auto.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/break.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/case.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/char.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/const.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/continue.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/default.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/do.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/double.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/else.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/enum.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/extern.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/float.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/for.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/goto.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/if.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/int.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/long.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/register.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/return.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/short.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/signed.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/sizeof.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/static.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/struct.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/switch.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/typedef.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/union.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/unsigned.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/void.h",
+    "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/volatile.h", "/usr/include/x86_64-linux-gnu/c++/12/bits/frozen/while.h"};
+
+static std::array<std::string, 32> const LongKeysCopy = [] {
+  std::array<std::string, 32> copy;
+  std::transform(LongKeys.begin(), LongKeys.end(), copy.begin(),
+                 [](frozen::string key) { return std::string(key.data(), key.size()); });
+  return copy;
+}();
+
+static void BM_LongStrInFzSet(benchmark::State& state) {
+  for (auto _ : state) {
+    for(auto const& kw : LongKeysCopy) {
+      volatile bool status = LongKeys.count(frozen::string(kw.data(), kw.size()));
+      benchmark::DoNotOptimize(status);
+    }
+  }
+}
+BENCHMARK(BM_LongStrInFzSet);
+
+static void BM_LongStrNotInFzSet(benchmark::State& state) {
+  std::array<std::string, 32> missing = LongKeysCopy;
+  for (auto& kw : missing)
+    kw.back() = 'c';
+  for (auto _ : state) {
+    for(auto const& kw : missing) {
+      volatile bool status = LongKeys.count(frozen::string(kw.data(), kw.size()));
+      benchmark::DoNotOptimize(status);
+    }
+  }
+}
+BENCHMARK(BM_LongStrNotInFzSet);
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/dynamic_unordered_map.h>
+#include <frozen/swappable.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+static std::vector<std::pair<int, int>> const& Config() {
+  static std::vector<std::pair<int, int>> const items = [] {
+    std::vector<std::pair<int, int>> config;
+    for (int i = 0; i < 1024; ++i)
+      config.emplace_back(i * 17, i);
+    return config;
+  }();
+  return items;
+}
+
+using FzConfig = frozen::dynamic_unordered_map<int, int>;
+
+static frozen::swappable<FzConfig>& FzTable() {
+  static frozen::swappable<FzConfig> table(
+      std::make_unique<FzConfig>(Config().begin(), Config().end()), 64);
+  return table;
+}
+
+// One snapshot per lookup, the worst case for the reader side.
+static void BM_SwappableLookup(benchmark::State& state) {
+  auto& table = FzTable();
+  auto reader = table.make_reader();
+  int key = state.thread_index() * 17;
+  for (auto _ : state) {
+    auto snapshot = reader.read();
+    auto where = snapshot->find(key);
+    benchmark::DoNotOptimize(where);
+    key = (key + 17 * 7) % (1024 * 17);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SwappableLookup)->ThreadRange(1, 16)->UseRealTime();
+
+static std::shared_timed_mutex StdMutex;
+static std::unordered_map<int, int> const StdTable(Config().begin(), Config().end());
+
+static void BM_SharedMutexLookup(benchmark::State& state) {
+  int key = state.thread_index() * 17;
+  for (auto _ : state) {
+    std::shared_lock<std::shared_timed_mutex> lock(StdMutex);
+    auto where = StdTable.find(key);
+    benchmark::DoNotOptimize(where);
+    key = (key + 17 * 7) % (1024 * 17);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedMutexLookup)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <frozen/perfect_hash.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Lookups of keys known to be present: find compares the key to the item
+// found, find_unchecked does not, and perfect_hash does not even store the
+// keys, the values living in a plain array.
+
+static constexpr frozen::string Paths[] = {
+  "/usr/share/doc/frozen/examples/enum_to_string.cpp",
+  "/usr/share/doc/frozen/examples/html_entities.cpp",
+  "/usr/share/doc/frozen/examples/json_keywords.cpp",
+  "/usr/share/doc/frozen/examples/static_routing.cpp",
+  "/usr/share/doc/frozen/examples/value_modification.cpp",
+  "/usr/share/doc/frozen/examples/pixel_art.cpp",
+  "/usr/share/doc/frozen/examples/mime_types.cpp",
+  "/usr/share/doc/frozen/examples/country_codes.cpp",
+};
+
+static constexpr std::pair<frozen::string, int> PathItems[] = {
+  {Paths[0], 0}, {Paths[1], 1}, {Paths[2], 2}, {Paths[3], 3},
+  {Paths[4], 4}, {Paths[5], 5}, {Paths[6], 6}, {Paths[7], 7},
+};
+
+static constexpr auto PathMap = frozen::make_unordered_map(PathItems);
+static constexpr auto PathHash = frozen::make_perfect_hash(Paths);
+static constexpr int PathValues[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+enum class Color { Red, Green, Blue, Cyan, Magenta, Yellow, Black, White };
+
+static constexpr Color Colors[] = {Color::Red,     Color::Green,  Color::Blue,  Color::Cyan,
+                                   Color::Magenta, Color::Yellow, Color::Black, Color::White};
+
+static constexpr std::pair<Color, int> ColorItems[] = {
+  {Color::Red, 0xFF0000},     {Color::Green, 0x00FF00},  {Color::Blue, 0x0000FF},  {Color::Cyan, 0x00FFFF},
+  {Color::Magenta, 0xFF00FF}, {Color::Yellow, 0xFFFF00}, {Color::Black, 0x000000}, {Color::White, 0xFFFFFF},
+};
+
+static constexpr auto ColorMap = frozen::make_unordered_map(ColorItems);
+
+// Copies of the keys, so that comparing them reads other memory than the
+// items, as keys parsed from some input would.
+template <std::size_t N>
+static std::vector<std::string> Copies(frozen::string const (&keys)[N]) {
+  std::vector<std::string> copies;
+  for (auto const &key : keys)
+    copies.emplace_back(key.data(), key.size());
+  return copies;
+}
+
+template <class Lookup>
+static void StrLookup(benchmark::State &state, Lookup const &lookup) {
+  auto const copies = Copies(Paths);
+  std::vector<frozen::string> keys;
+  for (auto const &copy : copies)
+    keys.emplace_back(copy.data(), copy.size());
+  auto const *volatile some = &keys;
+  for (auto _ : state) {
+    for (auto const &key : *some) {
+      volatile int value = lookup(key);
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(keys.size()));
+}
+
+static void BM_PathFind(benchmark::State &state) {
+  StrLookup(state, [](frozen::string const &key) { return PathMap.find(key)->second; });
+}
+BENCHMARK(BM_PathFind);
+static void BM_PathFindUnchecked(benchmark::State &state) {
+  StrLookup(state, [](frozen::string const &key) { return PathMap.find_unchecked(key)->second; });
+}
+BENCHMARK(BM_PathFindUnchecked);
+static void BM_PathPerfectHash(benchmark::State &state) {
+  StrLookup(state, [](frozen::string const &key) { return PathValues[PathHash(key)]; });
+}
+BENCHMARK(BM_PathPerfectHash);
+
+template <class Lookup>
+static void ColorLookup(benchmark::State &state, Lookup const &lookup) {
+  auto const *volatile some = &Colors;
+  for (auto _ : state) {
+    for (auto color : *some) {
+      volatile int value = lookup(color);
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(sizeof(Colors) / sizeof(Colors[0])));
+}
+
+static void BM_ColorFind(benchmark::State &state) {
+  ColorLookup(state, [](Color color) { return ColorMap.find(color)->second; });
+}
+BENCHMARK(BM_ColorFind);
+static void BM_ColorFindUnchecked(benchmark::State &state) {
+  ColorLookup(state, [](Color color) { return ColorMap.find_unchecked(color)->second; });
+}
+BENCHMARK(BM_ColorFindUnchecked);
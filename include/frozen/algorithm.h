@@ -23,169 +23,291 @@
 #ifndef FROZEN_LETITGO_ALGORITHM_H
 #define FROZEN_LETITGO_ALGORITHM_H
 
+#include "frozen/bits/algorithms.h"
 #include "frozen/bits/basic_types.h"
+#include "frozen/bits/defines.h"
+#include "frozen/bits/exceptions.h"
 #include "frozen/bits/version.h"
 #include "frozen/string.h"
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#ifdef FROZEN_LETITGO_HAS_STRING_VIEW
+#include <string_view>
+#endif
+
 namespace frozen {
 
 // 'search' implementation if C++17 is not available
 // https://en.cppreference.com/w/cpp/algorithm/search
 template<class ForwardIterator, class Searcher>
-ForwardIterator search(ForwardIterator first, ForwardIterator last, const Searcher & searcher)
+constexpr ForwardIterator search(ForwardIterator first, ForwardIterator last, const Searcher & searcher)
 {
   return searcher(first, last).first;
 }
 
+namespace bits {
+
+// The searcher kernels below only see a needle of `size_` characters stored in
+// a buffer of `capacity` characters. They are shared by the searchers built
+// from a string literal, where `size_ == capacity`, and by the searchers built
+// from a runtime needle, where `capacity` is an upper bound.
+
 // text book implementation from
 // https://en.wikipedia.org/wiki/Knuth%E2%80%93Morris%E2%80%93Pratt_algorithm
 
-template <std::size_t size> class knuth_morris_pratt_searcher {
-  bits::carray<std::ptrdiff_t, size> step_;
-  bits::carray<char, size> needle_;
+template <std::size_t capacity> class knuth_morris_pratt_searcher_impl {
+protected:
+  carray<char, capacity> needle_;
+  carray<std::ptrdiff_t, capacity + 1> step_;
+  std::size_t size_ = 0;
+
+  constexpr knuth_morris_pratt_searcher_impl(char const *needle, std::size_t size)
+    : size_(size) {
+    for (std::size_t i = 0; i < size; ++i)
+      needle_[i] = needle[i];
+    build_kmp_cache();
+  }
 
-  static constexpr bits::carray<std::ptrdiff_t, size>
-  build_kmp_cache(char const (&needle)[size + 1]) {
+private:
+  constexpr void build_kmp_cache() {
+    if (size_ == 0)
+      return;
     std::ptrdiff_t cnd = 0;
-    bits::carray<std::ptrdiff_t, size> cache(-1);
-    for (std::size_t pos = 1; pos < size; ++pos) {
-      if (needle[pos] == needle[cnd]) {
-        cache[pos] = cache[cnd];
-        cnd += 1;
+    step_[0] = -1;
+    for (std::size_t pos = 1; pos < size_; ++pos, ++cnd) {
+      if (needle_[pos] == needle_[cnd]) {
+        step_[pos] = step_[cnd];
       } else {
-        cache[pos] = cnd;
-        cnd = cache[cnd];
-        while (cnd >= 0 && needle[pos] != needle[cnd])
-          cnd = cache[cnd];
-        cnd += 1;
+        step_[pos] = cnd;
+        while (cnd >= 0 && needle_[pos] != needle_[cnd])
+          cnd = step_[cnd];
       }
     }
-    return cache;
+    // length of the longest proper border of the needle
+    step_[size_] = cnd;
   }
 
 public:
-  constexpr knuth_morris_pratt_searcher(char const (&needle)[size + 1])
-    : step_{build_kmp_cache(needle)}, needle_(needle) {}
+  constexpr std::size_t size() const { return size_; }
+  static constexpr std::size_t max_size() { return capacity; }
 
   template <class ForwardIterator>
   constexpr std::pair<ForwardIterator, ForwardIterator> operator()(ForwardIterator first, ForwardIterator last) const {
-    std::size_t i = 0;
+    if (size_ == 0)
+      return { first, first };
+
+    std::size_t matched = 0;
     ForwardIterator iter = first;
+    if (resume(iter, last, matched))
+      return { iter - size_, iter };
+    return { last, last };
+  }
+
+  // Resumable search: `matched` is the number of needle characters matched
+  // right before `iter`, possibly in a previous buffer. On success, `iter`
+  // points one past the end of the match and `matched` is set so that the
+  // scan can go on from there, otherwise `iter` is set to `last`.
+  template <class ForwardIterator>
+  constexpr bool resume(ForwardIterator &iter, ForwardIterator last, std::size_t &matched) const {
+    if (size_ == 0)
+      return false;
+
+    std::ptrdiff_t i = matched;
     while (iter != last) {
       if (needle_[i] == *iter) {
-        if (i == (size - 1))
-          return { iter - i, iter - i + size };
-        ++i;
         ++iter;
+        if (static_cast<std::size_t>(++i) == size_) {
+          matched = step_[size_];
+          return true;
+        }
       } else {
-        if (step_[i] > -1) {
-          i = step_[i];
-        } else {
+        i = step_[i];
+        if (i < 0) {
           ++iter;
           i = 0;
         }
       }
     }
-    return { last, last };
+    matched = i;
+    return false;
   }
-};
 
-template <std::size_t N>
-constexpr knuth_morris_pratt_searcher<N - 1> make_knuth_morris_pratt_searcher(char const (&needle)[N]) {
-  return {needle};
-}
+  template <class ForwardIterator>
+  constexpr bool find_next(ForwardIterator &cursor, ForwardIterator last, std::size_t &state,
+                           bool overlapping, ForwardIterator &match) const {
+    if (!resume(cursor, last, state))
+      return false;
+    match = cursor - size_;
+    if (!overlapping)
+      state = 0;
+    return true;
+  }
+};
 
 // text book implementation from
 // https://en.wikipedia.org/wiki/Boyer%E2%80%93Moore%E2%80%93Horspool_algorithm
 
-template <std::size_t size> class boyer_moore_searcher {
-  using skip_table_type = bits::carray<std::ptrdiff_t, sizeof(char) << 8>;
-  using suffix_table_type = bits::carray<std::ptrdiff_t, size>;
+template <std::size_t capacity> class boyer_moore_searcher_impl {
+  using skip_table_type = carray<std::ptrdiff_t, sizeof(char) << 8>;
+  using suffix_table_type = carray<std::ptrdiff_t, capacity>;
 
+protected:
   skip_table_type skip_table_;
   suffix_table_type suffix_table_;
-  bits::carray<char, size> needle_;
+  carray<char, capacity> needle_;
+  std::size_t size_ = 0;
+  std::size_t period_ = 0;
 
-  constexpr auto build_skip_table(char const (&needle)[size + 1]) {
-    skip_table_type skip_table(size);
-    for (std::size_t i = 0; i < size - 1; ++i)
-      skip_table[needle[i]] -= i + 1;
-    return skip_table;
+  constexpr boyer_moore_searcher_impl(char const *needle, std::size_t size)
+    : size_(size) {
+    for (std::size_t i = 0; i < size; ++i)
+      needle_[i] = needle[i];
+    build_skip_table();
+    build_suffix_table();
   }
 
-  constexpr bool is_prefix(char const (&needle)[size + 1], std::size_t pos) {
-    std::size_t suffixlen = size - pos;
-    
+  static constexpr std::size_t skip_index(char c) {
+    return static_cast<unsigned char>(c);
+  }
+
+private:
+  constexpr void build_skip_table() {
+    for (auto &skip : skip_table_)
+      skip = size_;
+    for (std::size_t i = 0; i + 1 < size_; ++i)
+      skip_table_[skip_index(needle_[i])] = size_ - 1 - i;
+  }
+
+  constexpr bool is_prefix(std::size_t pos) const {
+    std::size_t suffixlen = size_ - pos;
+
     for (std::size_t i = 0; i < suffixlen; i++) {
-      if (needle[i] != needle[pos + i])
+      if (needle_[i] != needle_[pos + i])
         return false;
     }
     return true;
   }
 
-  constexpr std::size_t suffix_length(char const (&needle)[size + 1],
-                                      std::size_t pos) {
+  constexpr std::size_t suffix_length(std::size_t pos) const {
     // increment suffix length slen to the first mismatch or beginning
     // of the word
     for (std::size_t slen = 0; slen < pos ; slen++)
-      if (needle[pos - slen] != needle[size - 1 - slen])
+      if (needle_[pos - slen] != needle_[size_ - 1 - slen])
         return slen;
 
     return pos;
   }
 
-  constexpr auto build_suffix_table(char const (&needle)[size + 1]) {
-    suffix_table_type suffix;
+  constexpr void build_suffix_table() {
+    if (size_ == 0)
+      return;
+
+    std::ptrdiff_t const size = size_;
     std::ptrdiff_t last_prefix_index = size - 1;
 
     // first loop
     for (std::ptrdiff_t p = size - 1; p >= 0; p--) {
-      if (is_prefix(needle, p + 1))
+      if (is_prefix(p + 1))
         last_prefix_index = p + 1;
 
-      suffix[p] = last_prefix_index + (size - 1 - p);
+      suffix_table_[p] = last_prefix_index + (size - 1 - p);
     }
+    // smallest shift of the needle over itself
+    period_ = last_prefix_index;
 
     // second loop
-    for (std::size_t p = 0; p < size - 1; p++) {
-      auto slen = suffix_length(needle, p);
-      if (needle[p - slen] != needle[size - 1 - slen])
-        suffix[size - 1 - slen] = size - 1 - p + slen;
-
+    for (std::size_t p = 0; p + 1 < size_; p++) {
+      auto slen = suffix_length(p);
+      if (needle_[p - slen] != needle_[size_ - 1 - slen])
+        suffix_table_[size_ - 1 - slen] = size_ - 1 - p + slen;
     }
-    return suffix;
   }
 
 public:
-  constexpr boyer_moore_searcher(char const (&needle)[size + 1])
-    : skip_table_{build_skip_table(needle)},
-      suffix_table_{build_suffix_table(needle)},
-      needle_(needle) {}
+  constexpr std::size_t size() const { return size_; }
+  static constexpr std::size_t max_size() { return capacity; }
 
   template <class RandomAccessIterator>
   constexpr std::pair<RandomAccessIterator, RandomAccessIterator> operator()(RandomAccessIterator first, RandomAccessIterator last) const {
-    if (size == 0)
+    if (size_ == 0)
       return { first, first };
 
-    if (size > size_t(last - first))
+    auto const match = find_from(first, last, 0);
+    if (match == last)
       return { last, last };
+    return { match, match + size_ };
+  }
 
-    RandomAccessIterator iter = first + size - 1;
-    while (true) {
+  // Finds the start of the next match in [first, last), knowing that the
+  // first `known` characters of the needle already match at `first`. Those
+  // are not compared again (Galil rule), which keeps dense matching linear.
+  template <class RandomAccessIterator>
+  constexpr RandomAccessIterator find_from(RandomAccessIterator first, RandomAccessIterator last, std::size_t known) const {
+    std::ptrdiff_t const size = size_;
+    std::ptrdiff_t floor = known;
+    while (last - first >= size) {
       std::ptrdiff_t j = size - 1;
-      while (j > 0 && (*iter == needle_[j])) {
-        --iter;
+      while (j >= floor && first[j] == needle_[j])
         --j;
-      }
-      if (j == 0 && *iter == needle_[0])
-        return { iter, iter + size};
+      if (j < floor)
+        return first;
 
-      std::ptrdiff_t jump = std::max(skip_table_[*iter], suffix_table_[j]);
-      if (jump >= last - iter)
-        return { last, last };
-      iter += jump;
+      std::ptrdiff_t const bad_char = skip_table_[skip_index(first[j])];
+      std::ptrdiff_t const good_suffix = suffix_table_[j];
+      std::ptrdiff_t const jump = bad_char < good_suffix ? good_suffix : bad_char;
+      first += j + jump - (size - 1);
+      floor = 0;
     }
+    return last;
   }
+
+  template <class RandomAccessIterator>
+  constexpr bool find_next(RandomAccessIterator &cursor, RandomAccessIterator last, std::size_t &state,
+                           bool overlapping, RandomAccessIterator &match) const {
+    if (size_ == 0)
+      return false;
+    match = find_from(cursor, last, state);
+    if (match == last) {
+      cursor = last;
+      return false;
+    }
+    // the needle cannot match again before its period
+    cursor = match + (overlapping ? period_ : size_);
+    state = overlapping ? size_ - period_ : 0;
+    return true;
+  }
+};
+
+template <std::size_t capacity>
+constexpr std::size_t check_needle_size(std::size_t size) {
+  return size <= capacity
+             ? size
+             : (FROZEN_THROW_OR_ABORT(std::length_error("needle exceeds searcher capacity")), size);
+}
+
+} // namespace bits
+
+template <std::size_t size>
+class knuth_morris_pratt_searcher : public bits::knuth_morris_pratt_searcher_impl<size> {
+public:
+  constexpr knuth_morris_pratt_searcher(char const (&needle)[size + 1])
+    : bits::knuth_morris_pratt_searcher_impl<size>(needle, size) {}
+};
+
+template <std::size_t N>
+constexpr knuth_morris_pratt_searcher<N - 1> make_knuth_morris_pratt_searcher(char const (&needle)[N]) {
+  return {needle};
+}
+
+template <std::size_t size>
+class boyer_moore_searcher : public bits::boyer_moore_searcher_impl<size> {
+public:
+  constexpr boyer_moore_searcher(char const (&needle)[size + 1])
+    : bits::boyer_moore_searcher_impl<size>(needle, size) {}
 };
 
 template <std::size_t N>
@@ -193,6 +315,453 @@ constexpr boyer_moore_searcher<N - 1> make_boyer_moore_searcher(char const (&nee
   return {needle};
 }
 
+// Searchers for needles only known at runtime, e.g. read from a configuration
+// file. The tables are built once, in place, for needles of at most `capacity`
+// characters: no dynamic allocation is involved.
+
+template <std::size_t capacity>
+class runtime_knuth_morris_pratt_searcher : public bits::knuth_morris_pratt_searcher_impl<capacity> {
+public:
+  constexpr runtime_knuth_morris_pratt_searcher(char const *needle, std::size_t size)
+    : bits::knuth_morris_pratt_searcher_impl<capacity>(needle, bits::check_needle_size<capacity>(size)) {}
+
+#ifdef FROZEN_LETITGO_HAS_STRING_VIEW
+  constexpr runtime_knuth_morris_pratt_searcher(std::string_view needle)
+    : runtime_knuth_morris_pratt_searcher(needle.data(), needle.size()) {}
+#endif
+};
+
+template <std::size_t capacity>
+class runtime_boyer_moore_searcher : public bits::boyer_moore_searcher_impl<capacity> {
+public:
+  constexpr runtime_boyer_moore_searcher(char const *needle, std::size_t size)
+    : bits::boyer_moore_searcher_impl<capacity>(needle, bits::check_needle_size<capacity>(size)) {}
+
+#ifdef FROZEN_LETITGO_HAS_STRING_VIEW
+  constexpr runtime_boyer_moore_searcher(std::string_view needle)
+    : runtime_boyer_moore_searcher(needle.data(), needle.size()) {}
+#endif
+};
+
+namespace bits {
+
+template <class Searcher, class = void>
+struct is_resumable_searcher : std::false_type {};
+
+template <class Searcher>
+struct is_resumable_searcher<Searcher,
+    decltype(void(std::declval<Searcher const &>().resume(
+        std::declval<char const *&>(), std::declval<char const *>(), std::declval<std::size_t &>())))>
+    : std::true_type {};
+
+template <class Searcher, class = void>
+struct has_find_next : std::false_type {};
+
+template <class Searcher>
+struct has_find_next<Searcher,
+    decltype(void(std::declval<Searcher const &>().find_next(
+        std::declval<char const *&>(), std::declval<char const *>(), std::declval<std::size_t &>(),
+        true, std::declval<char const *&>())))>
+    : std::true_type {};
+
+// Finds the match following the previous one, `cursor` and `state` carry the
+// searcher state from one call to the next and start at the beginning of the
+// haystack and zero. The frozen searchers resume from their internal state,
+// other searchers restart right after the previous match. `match` receives
+// the bounds of the match, as returned by the searcher for the others.
+template <class Searcher, class ForwardIterator>
+constexpr bool find_next(Searcher const &searcher, ForwardIterator &cursor, ForwardIterator last,
+                         std::size_t &state, bool overlapping,
+                         std::pair<ForwardIterator, ForwardIterator> &match, std::true_type) {
+  if (!searcher.find_next(cursor, last, state, overlapping, match.first))
+    return false;
+  match.second = std::next(match.first, searcher.size());
+  return true;
+}
+
+template <class Searcher, class ForwardIterator>
+constexpr bool find_next(Searcher const &searcher, ForwardIterator &cursor, ForwardIterator last,
+                         std::size_t &, bool overlapping,
+                         std::pair<ForwardIterator, ForwardIterator> &match, std::false_type) {
+  if (cursor == last)
+    return false;
+  auto const found = searcher(cursor, last);
+  if (found.first == found.second) {
+    cursor = last;
+    return false;
+  }
+  match.first = found.first;
+  match.second = found.second;
+  cursor = overlapping ? std::next(found.first) : found.second;
+  return true;
+}
+
+template <class Searcher, class ForwardIterator>
+constexpr bool find_next(Searcher const &searcher, ForwardIterator &cursor, ForwardIterator last,
+                         std::size_t &state, bool overlapping,
+                         std::pair<ForwardIterator, ForwardIterator> &match) {
+  return find_next(searcher, cursor, last, state, overlapping, match, has_find_next<Searcher>{});
+}
+
+// Same as above, for the start of the match only.
+template <class Searcher, class ForwardIterator>
+constexpr bool find_next(Searcher const &searcher, ForwardIterator &cursor, ForwardIterator last,
+                         std::size_t &state, bool overlapping, ForwardIterator &match, std::true_type) {
+  return searcher.find_next(cursor, last, state, overlapping, match);
+}
+
+template <class Searcher, class ForwardIterator>
+constexpr bool find_next(Searcher const &searcher, ForwardIterator &cursor, ForwardIterator last,
+                         std::size_t &state, bool overlapping, ForwardIterator &match, std::false_type) {
+  std::pair<ForwardIterator, ForwardIterator> found{match, match};
+  if (!find_next(searcher, cursor, last, state, overlapping, found, std::false_type{}))
+    return false;
+  match = found.first;
+  return true;
+}
+
+template <class Searcher, class ForwardIterator>
+constexpr bool find_next(Searcher const &searcher, ForwardIterator &cursor, ForwardIterator last,
+                         std::size_t &state, bool overlapping, ForwardIterator &match) {
+  return find_next(searcher, cursor, last, state, overlapping, match, has_find_next<Searcher>{});
+}
+
+} // namespace bits
+
+enum class match_mode { overlapping, non_overlapping };
+
+// Range of all the matches of a searcher in [first, last), as pairs of
+// iterators. The searcher state is kept from one match to the next, so
+// enumerating dense matches remains linear.
+template <class ForwardIterator, class Searcher>
+class match_range {
+  ForwardIterator first_, last_;
+  Searcher const *searcher_;
+  bool overlapping_;
+
+public:
+  class iterator {
+    ForwardIterator cursor_{}, last_{};
+    Searcher const *searcher_ = nullptr;
+    std::pair<ForwardIterator, ForwardIterator> match_{};
+    std::size_t state_ = 0;
+    bool overlapping_ = true;
+    bool done_ = true;
+
+    friend class match_range;
+
+    constexpr iterator(ForwardIterator first, ForwardIterator last, Searcher const *searcher, bool overlapping)
+        : cursor_(first), last_(last), searcher_(searcher), match_(last, last),
+          overlapping_(overlapping), done_(false) {
+      ++*this;
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<ForwardIterator, ForwardIterator>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type const *;
+    using reference = value_type const &;
+
+    constexpr iterator() = default;
+
+    constexpr reference operator*() const { return match_; }
+    constexpr pointer operator->() const { return &match_; }
+
+    constexpr iterator &operator++() {
+      if (!bits::find_next(*searcher_, cursor_, last_, state_, overlapping_, match_))
+        done_ = true;
+      return *this;
+    }
+    constexpr iterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    constexpr bool operator==(iterator const &other) const {
+      return done_ == other.done_ && (done_ || match_.first == other.match_.first);
+    }
+    constexpr bool operator!=(iterator const &other) const { return !(*this == other); }
+  };
+
+  using const_iterator = iterator;
+
+  constexpr match_range(ForwardIterator first, ForwardIterator last, Searcher const &searcher, match_mode mode)
+      : first_(first), last_(last), searcher_(&searcher), overlapping_(mode == match_mode::overlapping) {}
+
+  constexpr iterator begin() const { return {first_, last_, searcher_, overlapping_}; }
+  constexpr iterator end() const { return {}; }
+
+  constexpr bool empty() const { return begin() == end(); }
+
+  // Number of matches, without materializing them.
+  constexpr std::size_t count() const {
+    std::size_t found = 0, state = 0;
+    ForwardIterator cursor = first_, match = first_;
+    while (bits::find_next(*searcher_, cursor, last_, state, overlapping_, match))
+      ++found;
+    return found;
+  }
+};
+
+template <class ForwardIterator, class Searcher>
+constexpr match_range<ForwardIterator, Searcher> find_all(ForwardIterator first, ForwardIterator last,
+                                                          Searcher const &searcher,
+                                                          match_mode mode = match_mode::overlapping) {
+  return {first, last, searcher, mode};
+}
+
+// Search a stream delivered as a sequence of buffers, e.g. chunks read from a
+// file or a socket. Matches spanning several buffers are reported, and only
+// O(needle) context is kept between two calls to `feed`: the automaton state
+// for resumable searchers, the last `size() - 1` characters for the others.
+template <class Searcher>
+class stream_searcher {
+  using resumable = bits::is_resumable_searcher<Searcher>;
+
+  Searcher searcher_;
+  std::size_t offset_ = 0;
+  std::size_t matched_ = 0;
+  std::size_t carry_size_ = 0;
+  bits::carray<char, resumable::value ? 1 : 2 * Searcher::max_size()> carry_;
+
+public:
+  constexpr stream_searcher(Searcher const &searcher) : searcher_(searcher) {}
+
+  constexpr Searcher const &searcher() const { return searcher_; }
+
+  // Number of characters fed so far.
+  constexpr std::size_t offset() const { return offset_; }
+
+  constexpr void reset() {
+    offset_ = matched_ = carry_size_ = 0;
+  }
+
+  // Calls `on_match(offset)` with the absolute offset of the start of each
+  // match that ends in [first, last), in increasing order. Returns the number
+  // of matches.
+  template <class RandomAccessIterator, class Callback>
+  constexpr std::size_t feed(RandomAccessIterator first, RandomAccessIterator last, Callback &&on_match) {
+    auto const found = feed(first, last, on_match, resumable{});
+    offset_ += last - first;
+    return found;
+  }
+
+private:
+  template <class RandomAccessIterator, class Callback>
+  constexpr std::size_t feed(RandomAccessIterator first, RandomAccessIterator last, Callback &on_match, std::true_type) {
+    std::size_t found = 0;
+    for (auto iter = first; searcher_.resume(iter, last, matched_); ++found)
+      on_match(offset_ + static_cast<std::size_t>(iter - first) - searcher_.size());
+    return found;
+  }
+
+  template <class RandomAccessIterator, class Callback>
+  constexpr std::size_t feed(RandomAccessIterator first, RandomAccessIterator last, Callback &on_match, std::false_type) {
+    std::size_t const size = searcher_.size();
+    std::size_t const length = last - first;
+    std::size_t found = 0;
+    if (size == 0)
+      return found;
+
+    // Matches starting in the carried characters: search the junction made
+    // of the carried characters and the head of this buffer.
+    std::size_t const head = length < size - 1 ? length : size - 1;
+    for (std::size_t i = 0; i < head; ++i)
+      carry_[carry_size_ + i] = first[i];
+    auto const junction = carry_.begin();
+    auto const junction_end = junction + carry_size_ + head;
+    std::size_t state = 0;
+    for (auto cursor = junction, match = junction;
+         bits::find_next(searcher_, cursor, junction_end, state, true, match) &&
+         static_cast<std::size_t>(match - junction) < carry_size_;
+         ++found)
+      on_match(offset_ - carry_size_ + static_cast<std::size_t>(match - junction));
+
+    // Matches within this buffer.
+    state = 0;
+    for (auto cursor = first, match = first;
+         bits::find_next(searcher_, cursor, last, state, true, match);
+         ++found)
+      on_match(offset_ + static_cast<std::size_t>(match - first));
+
+    // Keep the last size - 1 characters of the stream.
+    if (length >= size - 1) {
+      for (std::size_t i = 0; i < size - 1; ++i)
+        carry_[i] = first[length - (size - 1) + i];
+      carry_size_ = size - 1;
+    } else {
+      std::size_t const total = carry_size_ + head;
+      std::size_t const kept = total < size - 1 ? total : size - 1;
+      for (std::size_t i = 0; i < kept; ++i)
+        carry_[i] = carry_[total - kept + i];
+      carry_size_ = kept;
+    }
+    return found;
+  }
+};
+
+template <class Searcher>
+constexpr stream_searcher<Searcher> make_stream_searcher(Searcher const &searcher) {
+  return {searcher};
+}
+
+// Suffix array of a constant text, for substring queries in O(m log n) where
+// m is the length of the needle. Built by prefix doubling with radix sorts,
+// O(n log n), and completed by the longest common prefix array (Kasai et al).
+// Large texts may require to raise the compiler constexpr limits, as in
+// -fconstexpr-steps (Clang) or -fconstexpr-ops-limit (GCC).
+template <std::size_t N>
+class suffix_array {
+public:
+  using index_type = bits::select_uint_least_t<bits::log(N) + 1>;
+  using const_iterator = index_type const *;
+
+private:
+  bits::carray<char, N> text_;
+  bits::carray<index_type, N> suffixes_;
+  bits::carray<index_type, N> lcp_;
+
+  static constexpr std::ptrdiff_t second_rank(bits::carray<index_type, N> const &rank, std::size_t i, std::size_t k) {
+    return i + k < N ? std::ptrdiff_t(rank[i + k]) : std::ptrdiff_t(-1);
+  }
+
+  constexpr void build_suffixes() {
+    // counting sort buckets, for characters first then for ranks
+    bits::carray<std::size_t, (N > 256 ? N : 256) + 1> counts;
+    bits::carray<index_type, N> rank, tmp;
+
+    for (std::size_t i = 0; i < N; ++i) {
+      rank[i] = static_cast<unsigned char>(text_[i]);
+      counts[rank[i] + 1] += 1;
+    }
+    for (std::size_t c = 1; c < counts.size(); ++c)
+      counts[c] += counts[c - 1];
+    for (std::size_t i = 0; i < N; ++i)
+      suffixes_[counts[rank[i]]++] = static_cast<index_type>(i);
+
+    // invariant: suffixes_ is sorted by the first k characters
+    for (std::size_t k = 1; k < N; k <<= 1) {
+      // order by the second half, from the current order
+      std::size_t p = 0;
+      for (std::size_t i = N - k; i < N; ++i)
+        tmp[p++] = static_cast<index_type>(i);
+      for (std::size_t i = 0; i < N; ++i)
+        if (suffixes_[i] >= k)
+          tmp[p++] = static_cast<index_type>(suffixes_[i] - k);
+
+      // stable sort by the first half
+      for (auto &count : counts)
+        count = 0;
+      for (std::size_t i = 0; i < N; ++i)
+        counts[rank[i]] += 1;
+      for (std::size_t c = 1; c < counts.size(); ++c)
+        counts[c] += counts[c - 1];
+      for (std::size_t i = N; i-- > 0;)
+        suffixes_[--counts[rank[tmp[i]]]] = tmp[i];
+
+      // rank by the first 2k characters
+      tmp[suffixes_[0]] = 0;
+      for (std::size_t i = 1; i < N; ++i) {
+        auto const curr = suffixes_[i], prev = suffixes_[i - 1];
+        tmp[curr] = tmp[prev] + (rank[curr] != rank[prev] ||
+                                 second_rank(rank, curr, k) != second_rank(rank, prev, k));
+      }
+      rank = tmp;
+      if (rank[suffixes_[N - 1]] == N - 1)
+        break;
+    }
+  }
+
+  constexpr void build_lcp() {
+    bits::carray<index_type, N> inverse;
+    for (std::size_t i = 0; i < N; ++i)
+      inverse[suffixes_[i]] = static_cast<index_type>(i);
+
+    std::size_t h = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      if (inverse[i] == 0) {
+        h = 0;
+        continue;
+      }
+      std::size_t const j = suffixes_[inverse[i] - 1];
+      while (i + h < N && j + h < N && text_[i + h] == text_[j + h])
+        ++h;
+      lcp_[inverse[i]] = static_cast<index_type>(h);
+      if (h > 0)
+        --h;
+    }
+  }
+
+  // Compares the suffix starting at `pos`, truncated to the needle length,
+  // with the needle.
+  constexpr int compare(std::size_t pos, string needle) const {
+    for (std::size_t i = 0; i < needle.size(); ++i) {
+      if (pos + i == N)
+        return -1;
+      if (text_[pos + i] != needle[i])
+        return static_cast<unsigned char>(text_[pos + i]) < static_cast<unsigned char>(needle[i]) ? -1 : 1;
+    }
+    return 0;
+  }
+
+  // First suffix comparing greater or equal (resp. greater) to the needle.
+  constexpr const_iterator bound(string needle, bool upper) const {
+    const_iterator first = suffixes_.begin();
+    std::size_t count = N;
+    while (count > 0) {
+      std::size_t const step = count / 2;
+      int const cmp = compare(first[step], needle);
+      if (cmp < 0 || (upper && cmp == 0)) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+public:
+  constexpr suffix_array(char const (&text)[N + 1]) : text_(text) {
+    build_suffixes();
+    build_lcp();
+  }
+
+  constexpr std::size_t size() const { return N; }
+
+  // Positions of all the suffixes, in lexicographical order.
+  constexpr const_iterator begin() const { return suffixes_.begin(); }
+  constexpr const_iterator end() const { return suffixes_.end(); }
+  constexpr index_type operator[](std::size_t i) const { return suffixes_[i]; }
+
+  // Length of the longest common prefix of the i-th suffix and the previous
+  // one, 0 for the first suffix.
+  constexpr index_type lcp(std::size_t i) const { return lcp_[i]; }
+
+  // Positions of all the occurrences of the needle in the text, in
+  // lexicographical order of the matching suffixes.
+  constexpr std::pair<const_iterator, const_iterator> locate(string needle) const {
+    return { bound(needle, false), bound(needle, true) };
+  }
+
+  constexpr std::size_t count(string needle) const {
+    auto const range = locate(needle);
+    return range.second - range.first;
+  }
+
+  constexpr bool contains(string needle) const {
+    auto const first = bound(needle, false);
+    return first != end() && compare(*first, needle) == 0;
+  }
+};
+
+template <std::size_t N>
+constexpr suffix_array<N - 1> make_suffix_array(char const (&text)[N]) {
+  return {text};
+}
+
 } // namespace frozen
 
 #endif
@@ -0,0 +1,323 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_AUTO_HASH_H
+#define FROZEN_LETITGO_AUTO_HASH_H
+
+#include "frozen/bits/basic_types.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/pmh.h"
+#include "frozen/hardware_hash.h"
+#include "frozen/position_hash.h"
+#include "frozen/random.h"
+#include "frozen/string.h"
+#include "frozen/unordered_map.h"
+#include "frozen/unordered_set.h"
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace frozen {
+
+// List of the hash families auto_hash picks from.
+template <class... Hashers> struct hash_candidates {};
+
+template <class Key, class = void> struct default_hash_candidates {
+  using type = hash_candidates<elsa<Key>>;
+};
+template <class Key>
+struct default_hash_candidates<Key, std::enable_if_t<std::is_integral<Key>::value || std::is_enum<Key>::value>> {
+  using type = hash_candidates<elsa<Key>, crc_hash<Key>, aes_hash<Key>>;
+};
+template <class CharT> struct default_hash_candidates<basic_string<CharT>> {
+  using type = hash_candidates<elsa<basic_string<CharT>>, incremental_elsa<basic_string<CharT>>,
+                               basic_position_hash<CharT>, crc_hash<basic_string<CharT>>,
+                               aes_hash<basic_string<CharT>>>;
+};
+
+template <class Candidates, std::size_t I> struct hash_candidate_element;
+template <class... Hashers, std::size_t I>
+struct hash_candidate_element<hash_candidates<Hashers...>, I> : std::tuple_element<I, std::tuple<Hashers...>> {};
+
+// The I-th hash family of Candidates, to name the choice of an auto_hash in
+// a container type.
+template <class Candidates, std::size_t I>
+using hash_candidate_t = typename hash_candidate_element<Candidates, I>::type;
+
+// How auto_hash builds a hash family for N keys, and its cost model: the
+// number of characters read plus mixing steps to hash a key once. Specialize
+// it to add a hash family. A specialization may also define `max_keys`, the
+// largest key set the family is tried on.
+template <class Hasher> struct hash_candidate {
+  template <std::size_t N, class Keys> static constexpr Hasher make(Keys const &) { return {}; }
+  template <class Key> static constexpr std::size_t cost(Hasher const &, Key const &) { return 1; }
+};
+
+template <class CharT> struct hash_candidate<elsa<basic_string<CharT>>> {
+  template <std::size_t N, class Keys> static constexpr elsa<basic_string<CharT>> make(Keys const &) { return {}; }
+  static constexpr std::size_t cost(elsa<basic_string<CharT>> const &, basic_string<CharT> key) {
+    return key.size() + 1;
+  }
+};
+
+template <class CharT> struct hash_candidate<incremental_elsa<basic_string<CharT>>> {
+  template <std::size_t N, class Keys> static constexpr incremental_elsa<basic_string<CharT>> make(Keys const &) {
+    return {};
+  }
+  static constexpr std::size_t cost(incremental_elsa<basic_string<CharT>> const &, basic_string<CharT> key) {
+    return key.size() + 2;
+  }
+};
+
+template <class CharT> struct hash_candidate<basic_position_hash<CharT>> {
+  // The position search goes past the default constexpr step limits of the
+  // compilers on larger sets.
+  static constexpr std::size_t max_keys = 256;
+
+  template <std::size_t N, class Keys> static constexpr basic_position_hash<CharT> make(Keys const &keys) {
+    return bits::select_positions<CharT, N>(keys);
+  }
+  static constexpr std::size_t cost(basic_position_hash<CharT> const &hash, basic_string<CharT> key) {
+    return hash.position_count() == basic_position_hash<CharT>::all_characters ? key.size() + 1
+                                                                                 : hash.position_count() + 2;
+  }
+};
+
+// The hardware families cost one step per instruction: a CRC per 8 bytes and
+// one for the length, an AES round per 16 bytes and two to finish. Integers
+// take one step.
+template <class T> struct hash_candidate<crc_hash<T>> {
+  template <std::size_t N, class Keys> static constexpr crc_hash<T> make(Keys const &) { return {}; }
+  static constexpr std::size_t cost(crc_hash<T> const &, T const &) { return 1; }
+};
+
+template <class CharT> struct hash_candidate<crc_hash<basic_string<CharT>>> {
+  template <std::size_t N, class Keys> static constexpr crc_hash<basic_string<CharT>> make(Keys const &) {
+    return {};
+  }
+  static constexpr std::size_t cost(crc_hash<basic_string<CharT>> const &, basic_string<CharT> key) {
+    constexpr std::size_t per_word = bits::hash_words<CharT>::per_word;
+    return (key.size() + per_word - 1) / per_word + 1;
+  }
+};
+
+template <class T> struct hash_candidate<aes_hash<T>> {
+  template <std::size_t N, class Keys> static constexpr aes_hash<T> make(Keys const &) { return {}; }
+  static constexpr std::size_t cost(aes_hash<T> const &, T const &) { return 1; }
+};
+
+template <class CharT> struct hash_candidate<aes_hash<basic_string<CharT>>> {
+  template <std::size_t N, class Keys> static constexpr aes_hash<basic_string<CharT>> make(Keys const &) {
+    return {};
+  }
+  static constexpr std::size_t cost(aes_hash<basic_string<CharT>> const &, basic_string<CharT> key) {
+    constexpr std::size_t per_block = 2 * bits::hash_words<CharT>::per_word;
+    return (key.size() + per_block - 1) / per_block + 2;
+  }
+};
+
+// What building the perfect hash tables of a key set took with one hash
+// family. The size of the tables only depends on the number of keys.
+struct hash_statistics {
+  std::size_t first_seeds = 0;
+  std::size_t second_seeds = 0;
+  std::size_t largest_bucket = 0;
+  // Modelled cost of hashing every key once, see hash_candidate.
+  std::size_t cost = 0;
+  // False if the family was not tried, the key set being larger than its
+  // hash_candidate::max_keys.
+  bool tried = true;
+
+  constexpr std::size_t seeds() const { return first_seeds + second_seeds; }
+};
+
+enum class hash_choice {
+  cheapest,     // lowest cost, then fewest seeds
+  fewest_seeds, // fewest seeds, that is fastest to build, then lowest cost
+};
+
+template <class Candidates> class auto_hash;
+
+// Hasher that holds every hash family of a hash_candidates list and forwards
+// to the one make_auto_hash picked for a key set. The statistics of all the
+// families are kept, to tell why it was picked.
+template <class... Hashers> class auto_hash<hash_candidates<Hashers...>> {
+  static constexpr std::size_t family_count = sizeof...(Hashers);
+
+  std::tuple<Hashers...> hashers_;
+  std::size_t family_;
+  bits::carray<hash_statistics, family_count> statistics_;
+
+  template <class Key>
+  constexpr std::size_t hash(Key const &, std::size_t, std::integral_constant<std::size_t, family_count>) const {
+    return 0;
+  }
+  template <class Key, std::size_t I>
+  constexpr std::size_t hash(Key const &key, std::size_t seed, std::integral_constant<std::size_t, I>) const {
+    return family_ == I ? std::get<I>(hashers_)(key, seed)
+                        : hash(key, seed, std::integral_constant<std::size_t, I + 1>{});
+  }
+
+public:
+  using candidates = hash_candidates<Hashers...>;
+
+  constexpr auto_hash(std::tuple<Hashers...> const &hashers, std::size_t family,
+                      bits::carray<hash_statistics, family_count> const &statistics)
+      : hashers_(hashers), family_(family), statistics_(statistics) {}
+
+  // Index of the picked family in candidates.
+  constexpr std::size_t family() const { return family_; }
+  template <std::size_t I> constexpr hash_candidate_t<candidates, I> const &get() const {
+    return std::get<I>(hashers_);
+  }
+
+  constexpr hash_statistics const &statistics() const { return statistics_[family_]; }
+  constexpr hash_statistics const &statistics(std::size_t family) const { return statistics_[family]; }
+
+  template <class Key> constexpr std::size_t operator()(Key const &key, std::size_t seed) const {
+    return hash(key, seed, std::integral_constant<std::size_t, 0>{});
+  }
+};
+
+namespace bits {
+
+template <class T, class... Ts> constexpr std::size_t type_index() {
+  bool const same[] = {std::is_same<T, Ts>::value..., true};
+  std::size_t i = 0;
+  while (!same[i])
+    ++i;
+  return i;
+}
+
+// Integer keys hashed by an auto_hash that picked elsa get the single level
+// tables of the default hasher.
+template <class Key, class... Hashers>
+struct multiply_shift_hash<Key, auto_hash<hash_candidates<Hashers...>>>
+    : std::integral_constant<bool, (type_index<elsa<Key>, Hashers...>() < sizeof...(Hashers))> {
+  static constexpr bool single_level(auto_hash<hash_candidates<Hashers...>> const &hash) {
+    return hash.family() == type_index<elsa<Key>, Hashers...>();
+  }
+};
+
+template <class Candidates, class Key>
+using hash_candidates_or_default =
+    typename std::conditional<std::is_void<Candidates>::value, typename default_hash_candidates<Key>::type,
+                              Candidates>::type;
+
+template <class Hasher, class = void>
+struct candidate_max_keys : std::integral_constant<std::size_t, static_cast<std::size_t>(-1)> {};
+template <class Hasher>
+struct candidate_max_keys<Hasher, decltype(void(hash_candidate<Hasher>::max_keys))>
+    : std::integral_constant<std::size_t, hash_candidate<Hasher>::max_keys> {};
+
+template <class Hasher, std::size_t N, class Keys>
+constexpr Hasher make_candidate(Keys const &keys) {
+  return N <= candidate_max_keys<Hasher>::value ? hash_candidate<Hasher>::template make<N>(keys) : Hasher{};
+}
+
+constexpr hash_statistics untried_hash() {
+  hash_statistics statistics;
+  statistics.tried = false;
+  return statistics;
+}
+
+template <class Hasher, class Item, std::size_t N, class Key, class KeyEqual>
+constexpr hash_statistics measure_hash(Hasher const &hash, carray<Item, N> const &items, Key const &key,
+                                       KeyEqual const &equal) {
+  pmh_build_stats build;
+  make_pmh_tables<pmh_storage_size(N)>(items, hash, equal, key, default_prg_t{}, build);
+  hash_statistics statistics;
+  statistics.first_seeds = build.first_seeds;
+  statistics.second_seeds = build.second_seeds;
+  statistics.largest_bucket = build.largest_bucket;
+  for (std::size_t i = 0; i < N; ++i)
+    statistics.cost += hash_candidate<Hasher>::cost(hash, key(items[i]));
+  return statistics;
+}
+
+constexpr bool better_hash(hash_statistics const &lhs, hash_statistics const &rhs, hash_choice choice) {
+  return choice == hash_choice::cheapest
+             ? lhs.cost < rhs.cost || (lhs.cost == rhs.cost && lhs.seeds() < rhs.seeds())
+             : lhs.seeds() < rhs.seeds() || (lhs.seeds() == rhs.seeds() && lhs.cost < rhs.cost);
+}
+
+// Builds the tables of `items` with each family, as the containers would,
+// and keeps the best one: costs one table build per family tried.
+template <class... Hashers, class Item, std::size_t N, class Key, class KeyEqual, class Keys, std::size_t... Is>
+constexpr auto_hash<hash_candidates<Hashers...>>
+make_auto_hash(carray<Item, N> const &items, Key const &key, KeyEqual const &equal, Keys const &keys,
+               hash_choice choice, std::index_sequence<Is...>) {
+  std::tuple<Hashers...> const hashers{make_candidate<Hashers, N>(keys)...};
+  carray<hash_statistics, sizeof...(Hashers)> const statistics{
+      (N <= candidate_max_keys<Hashers>::value ? measure_hash(std::get<Is>(hashers), items, key, equal)
+                                               : untried_hash())...};
+  std::size_t family = 0;
+  for (std::size_t i = 1; i < sizeof...(Hashers); ++i)
+    if (statistics[i].tried &&
+        (!statistics[family].tried || better_hash(statistics[i], statistics[family], choice)))
+      family = i;
+  return {hashers, family, statistics};
+}
+
+template <class... Hashers, class Item, std::size_t N, class Key, class KeyEqual, class Keys>
+constexpr auto_hash<hash_candidates<Hashers...>>
+make_auto_hash(hash_candidates<Hashers...>, carray<Item, N> const &items, Key const &key, KeyEqual const &equal,
+               Keys const &keys, hash_choice choice) {
+  return make_auto_hash<Hashers...>(items, key, equal, keys, choice, std::index_sequence_for<Hashers...>{});
+}
+
+} // namespace bits
+
+// auto_hash for the keys of a set or a map, picked among Candidates, by
+// default the default_hash_candidates of the key type.
+template <class Candidates = void, class Key, std::size_t N>
+constexpr auto make_auto_hash(Key const (&keys)[N], hash_choice choice = hash_choice::cheapest) {
+  return bits::make_auto_hash(bits::hash_candidates_or_default<Candidates, Key>{}, bits::carray<Key, N>{keys},
+                              bits::Get{}, std::equal_to<Key>{}, keys, choice);
+}
+template <class Candidates = void, class Key, class Value, std::size_t N>
+constexpr auto make_auto_hash(std::pair<Key, Value> const (&items)[N], hash_choice choice = hash_choice::cheapest) {
+  return bits::make_auto_hash(bits::hash_candidates_or_default<Candidates, Key>{},
+                              bits::carray<std::pair<Key, Value>, N>{items}, bits::GetKey{}, std::equal_to<Key>{},
+                              bits::position_keys<std::pair<Key, Value>>{items}, choice);
+}
+
+// unordered_set and unordered_map hashed by make_auto_hash.
+template <class Candidates = void, class Key, std::size_t N>
+constexpr auto make_auto_unordered_set(Key const (&keys)[N], hash_choice choice = hash_choice::cheapest) {
+  using hasher = auto_hash<bits::hash_candidates_or_default<Candidates, Key>>;
+  return unordered_set<Key, N, hasher>{keys, make_auto_hash<Candidates>(keys, choice), std::equal_to<Key>{}};
+}
+template <class Candidates = void, class Key, class Value, std::size_t N>
+constexpr auto make_auto_unordered_map(std::pair<Key, Value> const (&items)[N],
+                                       hash_choice choice = hash_choice::cheapest) {
+  using hasher = auto_hash<bits::hash_candidates_or_default<Candidates, Key>>;
+  return unordered_map<Key, Value, N, hasher>{items, make_auto_hash<Candidates>(items, choice),
+                                              std::equal_to<Key>{}};
+}
+
+} // namespace frozen
+
+#endif
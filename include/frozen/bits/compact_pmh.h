@@ -0,0 +1,514 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_BITS_COMPACT_PMH_H
+#define FROZEN_LETITGO_BITS_COMPACT_PMH_H
+
+#include "frozen/bits/algorithms.h"
+#include "frozen/bits/defines.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/bits/pmh.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(FROZEN_LETITGO_IS_MSVC) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace frozen {
+
+namespace bits {
+
+inline std::uint64_t mul_hi64(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128;
+  return static_cast<std::uint64_t>((static_cast<uint128>(a) * b) >> 64);
+#elif defined(FROZEN_LETITGO_IS_MSVC) && defined(_M_X64)
+  return __umulh(a, b);
+#else
+  std::uint64_t const a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+  std::uint64_t const b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+  std::uint64_t const mid = (a_lo * b_lo >> 32) + (a_hi * b_lo & 0xFFFFFFFFu) + a_lo * b_hi;
+  return a_hi * b_hi + (a_hi * b_lo >> 32) + (mid >> 32);
+#endif
+}
+
+inline std::size_t popcount64(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+  word -= (word >> 1) & 0x5555555555555555ull;
+  word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+  return static_cast<std::size_t>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// Position of the lowest set bit of a non zero word.
+inline std::size_t lowest_bit64(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+  return popcount64((word & (0 - word)) - 1);
+#endif
+}
+
+// Finalizer of MurmurHash3: spreads every bit of the hash of a key to all the
+// bits used to select its bucket and its slot.
+inline std::uint64_t compact_pmh_mix(std::uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDull;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// `count` integers of `width` bits each, stored back to back in 64-bit words.
+// A trailing word lets reads load two words without checking for the end.
+class packed_ints {
+  std::size_t width_ = 0;
+  std::vector<std::uint64_t> words_ = std::vector<std::uint64_t>(1);
+
+public:
+  packed_ints() = default;
+  packed_ints(std::size_t count, std::size_t width)
+    : width_(width), words_((count * width + 63) / 64 + 1) {}
+
+  std::uint64_t operator[](std::size_t i) const {
+    std::size_t const bit = i * width_;
+    std::uint64_t const *word = words_.data() + bit / 64;
+    std::size_t const offset = bit % 64;
+    std::uint64_t const value = (word[0] >> offset) | ((word[1] << 1) << (63 - offset));
+    return width_ == 64 ? value : value & ((std::uint64_t(1) << width_) - 1);
+  }
+
+  // `value` must fit in width() bits, and item i must not be set yet.
+  void set(std::size_t i, std::uint64_t value) {
+    std::size_t const bit = i * width_;
+    std::size_t const offset = bit % 64;
+    words_[bit / 64] |= value << offset;
+    if (offset + width_ > 64)
+      words_[bit / 64 + 1] |= value >> (64 - offset);
+  }
+
+  std::uint64_t const *data() const noexcept { return words_.data(); }
+  std::size_t width() const noexcept { return width_; }
+  std::size_t size_in_bits() const noexcept { return 64 * words_.size(); }
+};
+
+// Number of bits needed to write any integer of [0, count).
+inline std::size_t bit_width_for(std::size_t count) {
+  return count > 1 ? log(count - 1) + 1 : 0;
+}
+
+// Sequence of 64-bit values, each one stored as an index of width(distinct
+// values) bits in a dictionary of the distinct values. Small when a few
+// values are much more frequent than the others: the dictionary is sorted
+// by decreasing frequency.
+class dictionary_ints {
+  std::vector<std::uint64_t> dictionary_;
+  packed_ints indices_;
+
+public:
+  dictionary_ints() = default;
+  explicit dictionary_ints(std::vector<std::uint64_t> const &values) {
+    std::vector<std::pair<std::uint64_t, std::size_t>> counts;
+    {
+      std::vector<std::uint64_t> sorted(values);
+      std::sort(sorted.begin(), sorted.end());
+      for (std::size_t i = 0; i < sorted.size(); ++i) {
+        if (i == 0 || sorted[i] != sorted[i - 1])
+          counts.emplace_back(sorted[i], 0);
+        counts.back().second += 1;
+      }
+    }
+    std::sort(counts.begin(), counts.end(),
+              [](std::pair<std::uint64_t, std::size_t> const &lhs, std::pair<std::uint64_t, std::size_t> const &rhs) {
+                return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+              });
+    dictionary_.reserve(counts.size());
+    for (auto const &count : counts)
+      dictionary_.push_back(count.first);
+
+    indices_ = packed_ints(values.size(), bit_width_for(dictionary_.size()));
+    std::vector<std::pair<std::uint64_t, std::size_t>> index_of(counts.size());
+    for (std::size_t i = 0; i < counts.size(); ++i)
+      index_of[i] = {dictionary_[i], i};
+    std::sort(index_of.begin(), index_of.end());
+    for (std::size_t i = 0; i < values.size(); ++i)
+      indices_.set(i, std::lower_bound(index_of.begin(), index_of.end(), std::make_pair(values[i], std::size_t(0)))->second);
+  }
+
+  std::uint64_t operator[](std::size_t i) const { return dictionary_[indices_[i]]; }
+
+  void prefetch(std::size_t i) const {
+    FROZEN_LETITGO_PREFETCH(indices_.data() + i * indices_.width() / 64);
+  }
+
+  std::size_t distinct_values() const noexcept { return dictionary_.size(); }
+  std::size_t size_in_bits() const noexcept {
+    return 64 * dictionary_.size() + indices_.size_in_bits();
+  }
+};
+
+// Non decreasing sequence of integers in [0, universe), Elias-Fano coded in
+// about 2 + log(universe / size) bits per value: the low bits of each value
+// are packed, the high ones written in unary in a bitvector, where the value
+// i is found by looking for its i-th set bit. The position of every
+// elias_fano_sample-th set bit is kept to start that search close to it.
+constexpr std::size_t elias_fano_sample = 256;
+
+class elias_fano {
+  std::size_t low_width_ = 0;
+  packed_ints low_;
+  std::vector<std::uint64_t> high_;
+  std::vector<std::size_t> samples_;
+
+public:
+  elias_fano() = default;
+  elias_fano(std::vector<std::uint64_t> const &values, std::uint64_t universe)
+    : low_width_(values.empty() || universe <= values.size() ? 0 : log(universe / values.size()))
+    , low_(values.size(), low_width_)
+    , high_(((universe >> low_width_) + values.size()) / 64 + 2) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      low_.set(i, values[i] & ((std::uint64_t(1) << low_width_) - 1));
+      std::size_t const bit = static_cast<std::size_t>(values[i] >> low_width_) + i;
+      high_[bit / 64] |= std::uint64_t(1) << (bit % 64);
+      if (i % elias_fano_sample == 0)
+        samples_.push_back(bit);
+    }
+  }
+
+  std::uint64_t operator[](std::size_t i) const {
+    std::size_t const sample = samples_[i / elias_fano_sample];
+    std::size_t rank = i % elias_fano_sample;
+    std::size_t word = sample / 64;
+    std::uint64_t bits = high_[word] & (~std::uint64_t(0) << (sample % 64));
+    for (std::size_t ones = popcount64(bits); rank >= ones; ones = popcount64(bits)) {
+      rank -= ones;
+      bits = high_[++word];
+    }
+    for (; rank; --rank)
+      bits &= bits - 1;
+    std::uint64_t const high = 64 * word + lowest_bit64(bits) - i;
+    return (high << low_width_) | low_[i];
+  }
+
+  std::size_t size_in_bits() const noexcept {
+    return low_.size_in_bits() + 64 * high_.size() + 64 * samples_.size();
+  }
+};
+
+// Number of buckets per key of compact_pmh_tables, over log(keys): more
+// buckets make the build faster and the tables larger, see PTHash [Pibiri
+// and Trani, SIGIR 2021], whose layout these tables follow.
+constexpr std::size_t compact_pmh_c = 5;
+
+// Slots of compact_pmh_tables per 100 keys.
+constexpr std::size_t compact_pmh_slots_percent = 102;
+
+// Number of pilots tried for a bucket before trying another seed.
+constexpr std::uint64_t compact_pmh_max_pilot = std::uint64_t(1) << 24;
+
+// Share of the keys, as the top of the range of their 64-bit hashes, sent to
+// the first 30% of the buckets: the larger buckets are placed first, while
+// most slots are free, and the pilots of the smaller ones stay small.
+constexpr std::uint64_t compact_pmh_dense_keys = 0x9999999999999999ull; // 60%
+
+inline std::uint64_t compact_pmh_pilot_hash(std::uint64_t pilot) {
+  return compact_pmh_mix(pilot + 0x9E3779B97F4A7C15ull);
+}
+
+// Minimal perfect hash function built at runtime, which maps the N keys to
+// [0, N) in about 3 bits per key. Unlike dynamic_pmh_tables, there is no
+// second table of item indices: the items are stored in the order of their
+// hashes. Each bucket of keys gets a small integer, its pilot, chosen so
+// that hashing the keys of the bucket with it sends them to free slots.
+// Slots are about 2% more than keys, the slots past N are mapped back to the
+// free slots below N by an Elias-Fano coded table. Pilots are stored as
+// dictionary coded hashes, the dense and the sparse buckets in two
+// dictionaries.
+template <class Hasher>
+class compact_pmh_tables : private Hasher {
+  std::uint64_t seed_ = 0;
+  std::size_t size_ = 0;
+  std::size_t slots_ = 1;
+  std::size_t dense_buckets_ = 1;
+  std::size_t sparse_buckets_ = 1;
+  dictionary_ints dense_pilots_;
+  dictionary_ints sparse_pilots_;
+  elias_fano free_slots_;
+
+public:
+  compact_pmh_tables(std::uint64_t seed, std::size_t size, std::size_t slots,
+                     std::size_t dense_buckets, std::size_t sparse_buckets,
+                     dictionary_ints dense_pilots, dictionary_ints sparse_pilots,
+                     elias_fano free_slots, Hasher const &hash)
+    : Hasher(hash)
+    , seed_(seed)
+    , size_(size)
+    , slots_(slots)
+    , dense_buckets_(dense_buckets)
+    , sparse_buckets_(sparse_buckets)
+    , dense_pilots_(std::move(dense_pilots))
+    , sparse_pilots_(std::move(sparse_pilots))
+    , free_slots_(std::move(free_slots))
+  {}
+
+  Hasher const& hash_function() const noexcept {
+    return static_cast<Hasher const&>(*this);
+  }
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t slot_count() const noexcept { return slots_; }
+  std::size_t bucket_count() const noexcept { return dense_buckets_ + sparse_buckets_; }
+
+  // Memory used by the tables, in bits.
+  std::size_t size_in_bits() const noexcept {
+    return 8 * sizeof(*this) + dense_pilots_.size_in_bits() +
+           sparse_pilots_.size_in_bits() + free_slots_.size_in_bits();
+  }
+
+  // Bucket of a key, the sparse ones numbered after the dense ones.
+  std::size_t bucket(std::uint64_t hash) const {
+    std::uint64_t const bits = (hash << 32) | (hash >> 32);
+    return hash < compact_pmh_dense_keys
+               ? static_cast<std::size_t>(mul_hi64(bits, dense_buckets_))
+               : dense_buckets_ + static_cast<std::size_t>(mul_hi64(bits, sparse_buckets_));
+  }
+
+  std::size_t slot(std::uint64_t hash, std::uint64_t pilot_hash) const {
+    return static_cast<std::size_t>(mul_hi64((hash ^ pilot_hash) * 0x9E3779B97F4A7C15ull, slots_));
+  }
+
+  std::uint64_t pilot_hash(std::size_t bucket) const {
+    return bucket < dense_buckets_ ? dense_pilots_[bucket] : sparse_pilots_[bucket - dense_buckets_];
+  }
+
+  template <typename KeyType>
+  std::size_t lookup(const KeyType & key) const {
+    return lookup(key, hash_function());
+  }
+
+  // Index in [0, size()) of the key, if it is one of the keys of the tables.
+  // Any index in that range otherwise, size() when there are no keys.
+  template <typename KeyType, typename HasherType>
+  std::size_t lookup(const KeyType & key, const HasherType& hasher) const {
+    std::uint64_t const hash = compact_pmh_mix(hasher(key, static_cast<std::size_t>(seed_)));
+    std::size_t const s = slot(hash, pilot_hash(bucket(hash)));
+    return s < size_ ? s : static_cast<std::size_t>(free_slots_[s - size_]);
+  }
+
+  // Same as pmh_lookup_batch.
+  template <typename KeyIt, typename HasherType>
+  void lookup_batch(KeyIt keys, std::size_t count, const HasherType& hasher, std::size_t *indices) const {
+    std::uint64_t hashes[pmh_batch_size];
+    std::size_t buckets[pmh_batch_size];
+    for (std::size_t i = 0; i < count; ++i) {
+      hashes[i] = compact_pmh_mix(hasher(keys[i], static_cast<std::size_t>(seed_)));
+      buckets[i] = bucket(hashes[i]);
+      if (buckets[i] < dense_buckets_)
+        dense_pilots_.prefetch(buckets[i]);
+      else
+        sparse_pilots_.prefetch(buckets[i] - dense_buckets_);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      std::size_t const s = slot(hashes[i], pilot_hash(buckets[i]));
+      indices[i] = s < size_ ? s : static_cast<std::size_t>(free_slots_[s - size_]);
+    }
+  }
+};
+
+// Tables and items of a compact_pmh_tables build, the items in the order of
+// their hashes.
+template <class Item, class Hasher>
+struct compact_pmh_build {
+  std::vector<Item> items;
+  compact_pmh_tables<Hasher> tables;
+};
+
+// Pilot search of make_compact_pmh for one seed. Fills `slot_of`, the slot
+// of each item, and returns false when a bucket needs more than
+// compact_pmh_max_pilot pilots, or two items of a bucket have the same hash.
+// In the latter case, `duplicate` is set if their keys are equal.
+template <class Items, class Key, class KeyEqual, class Hash>
+bool place_compact_pmh(Items const &items, compact_pmh_tables<Hash> const &layout,
+                       KeyEqual const &equal, Key const &key,
+                       std::vector<std::uint64_t> const &hashes,
+                       std::vector<std::uint64_t> &pilots,
+                       std::vector<std::size_t> &slot_of, bool &duplicate) {
+  std::size_t const N = hashes.size();
+  std::size_t const B = layout.bucket_count();
+
+  // Step 1: Place all of the keys into buckets, sorted by hash in a bucket.
+  std::vector<std::size_t> bucket_start(B + 1);
+  std::vector<std::size_t> bucket_of(N);
+  for (std::size_t i = 0; i < N; ++i) {
+    bucket_of[i] = layout.bucket(hashes[i]);
+    bucket_start[bucket_of[i] + 1] += 1;
+  }
+  std::size_t bucket_max = 0;
+  for (std::size_t b = 0; b < B; ++b) {
+    bucket_max = std::max(bucket_max, bucket_start[b + 1]);
+    bucket_start[b + 1] += bucket_start[b];
+  }
+  std::vector<std::size_t> bucket_items(N);
+  {
+    std::vector<std::size_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+    for (std::size_t i = 0; i < N; ++i)
+      bucket_items[fill[bucket_of[i]]++] = i;
+  }
+
+  // Step 1.5: Detect items with the same hash, no pilot can separate them.
+  for (std::size_t b = 0; b < B; ++b) {
+    auto const first = bucket_items.begin() + bucket_start[b];
+    auto const last = bucket_items.begin() + bucket_start[b + 1];
+    std::sort(first, last, [&hashes](std::size_t lhs, std::size_t rhs) { return hashes[lhs] < hashes[rhs]; });
+    for (auto it = first; last - it > 1; ++it) {
+      if (hashes[it[0]] == hashes[it[1]]) {
+        duplicate = equal(key(items[it[0]]), key(items[it[1]]));
+        return false;
+      }
+    }
+  }
+
+  // Step 2: Sort the buckets to process the ones with the most items first.
+  std::vector<std::size_t> buckets(B);
+  {
+    std::vector<std::size_t> by_size(bucket_max + 2);
+    for (std::size_t b = 0; b < B; ++b)
+      by_size[bucket_max - (bucket_start[b + 1] - bucket_start[b]) + 1] += 1;
+    for (std::size_t s = 1; s < by_size.size(); ++s)
+      by_size[s] += by_size[s - 1];
+    for (std::size_t b = 0; b < B; ++b)
+      buckets[by_size[bucket_max - (bucket_start[b + 1] - bucket_start[b])]++] = b;
+  }
+
+  // Step 3: Search the pilot of each bucket, the first one that sends its
+  // items to distinct free slots.
+  std::vector<std::uint64_t> taken((layout.slot_count() + 63) / 64);
+  std::vector<std::size_t> bucket_slots;
+  bucket_slots.reserve(bucket_max);
+  std::fill(pilots.begin(), pilots.end(), 0);
+  for (auto const bucket : buckets) {
+    auto const first = bucket_items.begin() + bucket_start[bucket];
+    auto const bsize = bucket_start[bucket + 1] - bucket_start[bucket];
+    if (!bsize)
+      break;
+
+    for (std::uint64_t pilot = 0;; ++pilot) {
+      if (pilot == compact_pmh_max_pilot)
+        return false;
+      std::uint64_t const pilot_hash = compact_pmh_pilot_hash(pilot);
+      bucket_slots.clear();
+      for (std::size_t i = 0; i < bsize; ++i) {
+        std::size_t const s = layout.slot(hashes[first[i]], pilot_hash);
+        if (((taken[s / 64] >> (s % 64)) & 1) ||
+            std::find(bucket_slots.begin(), bucket_slots.end(), s) != bucket_slots.end())
+          break;
+        bucket_slots.push_back(s);
+      }
+      if (bucket_slots.size() < bsize)
+        continue;
+
+      pilots[bucket] = pilot;
+      for (std::size_t i = 0; i < bsize; ++i) {
+        taken[bucket_slots[i] / 64] |= std::uint64_t(1) << (bucket_slots[i] % 64);
+        slot_of[first[i]] = bucket_slots[i];
+      }
+      break;
+    }
+  }
+  return true;
+}
+
+// Builds the compact_pmh_tables of `items`, and moves the items in the order
+// of the tables.
+template <class Item, class Hash, class Key, class KeyEqual, class PRG>
+compact_pmh_build<Item, Hash> make_compact_pmh(std::vector<Item> items,
+                                               Hash const &hash,
+                                               KeyEqual const &equal,
+                                               Key const &key,
+                                               PRG prg) {
+  std::size_t const N = items.size();
+  std::size_t const M = N * compact_pmh_slots_percent / 100 + 1;
+  std::size_t const B = std::max<std::size_t>(2, N * compact_pmh_c / std::max<std::size_t>(1, log(N)));
+  std::size_t const dense_buckets = std::max<std::size_t>(1, B * 3 / 10);
+  std::size_t const sparse_buckets = B - dense_buckets;
+
+  std::vector<std::uint64_t> hashes(N);
+  std::vector<std::uint64_t> pilots(B);
+  std::vector<std::size_t> slot_of(N);
+  std::uint64_t seed;
+  while (true) {
+    seed = prg();
+    for (std::size_t i = 0; i < N; ++i)
+      hashes[i] = compact_pmh_mix(hash(key(items[i]), static_cast<std::size_t>(seed)));
+    compact_pmh_tables<Hash> const layout{seed, N, M, dense_buckets, sparse_buckets, {}, {}, {}, hash};
+    bool duplicate = false;
+    if (place_compact_pmh(items, layout, equal, key, hashes, pilots, slot_of, duplicate))
+      break;
+    if (duplicate)
+      FROZEN_THROW_OR_ABORT(std::invalid_argument("structure keys should be unique"));
+  }
+
+  // Slots past N, taken or not, are mapped back to the free slots below N,
+  // in order, which keeps the mapping non decreasing.
+  std::vector<std::size_t> item_at(M, N);
+  for (std::size_t i = 0; i < N; ++i)
+    item_at[slot_of[i]] = i;
+  std::vector<std::uint64_t> free_slots(M - N);
+  for (std::size_t s = N, next = 0, last = 0; s < M; ++s) {
+    if (item_at[s] != N) {
+      while (item_at[next] != N)
+        ++next;
+      item_at[next] = item_at[s];
+      last = next++;
+    }
+    free_slots[s - N] = last;
+  }
+
+  std::vector<std::uint64_t> dense(dense_buckets), sparse(sparse_buckets);
+  for (std::size_t b = 0; b < B; ++b)
+    (b < dense_buckets ? dense[b] : sparse[b - dense_buckets]) = compact_pmh_pilot_hash(pilots[b]);
+
+  std::vector<Item> ordered;
+  ordered.reserve(N);
+  for (std::size_t s = 0; s < N; ++s)
+    ordered.push_back(std::move(items[item_at[s]]));
+
+  return {std::move(ordered),
+          {seed, N, M, dense_buckets, sparse_buckets, dictionary_ints(dense),
+           dictionary_ints(sparse), elias_fano(free_slots, std::max<std::size_t>(N, 1)), hash}};
+}
+
+} // namespace bits
+
+} // namespace frozen
+
+#endif
@@ -30,5 +30,9 @@ inline void constexpr_assert_failed() {}
 
 #define constexpr_assert(cond, msg) ((void)((cond) ? 0 : (constexpr_assert_failed(), 0)))
 
+// Checks a precondition the caller vouches for, in debug builds only: same as
+// assert, compiled out when NDEBUG is defined.
+#define FROZEN_LETITGO_DEBUG_ASSERT(cond, msg) assert((cond) && msg)
+
 #endif
 
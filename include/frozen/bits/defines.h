@@ -63,4 +63,23 @@
   #define FROZEN_LETITGO_HAS_CONSTEXPR_STRING
 #endif
 
+// Lets constexpr functions take a faster, non constexpr path at runtime.
+// The builtin is available to C++14 code as well.
+#if defined(__has_builtin)
+  #if __has_builtin(__builtin_is_constant_evaluated)
+    #define FROZEN_LETITGO_HAS_IS_CONSTANT_EVALUATED
+  #endif
+#endif
+#if !defined(FROZEN_LETITGO_HAS_IS_CONSTANT_EVALUATED) && \
+    ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || \
+     (defined(_MSC_VER) && _MSC_VER >= 1925))
+  #define FROZEN_LETITGO_HAS_IS_CONSTANT_EVALUATED
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+  #define FROZEN_LETITGO_PREFETCH(address) __builtin_prefetch(address)
+#else
+  #define FROZEN_LETITGO_PREFETCH(address) static_cast<void>(address)
+#endif
+
 #endif // FROZEN_LETITGO_DEFINES_H
@@ -0,0 +1,531 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_BITS_DYNAMIC_PMH_H
+#define FROZEN_LETITGO_BITS_DYNAMIC_PMH_H
+
+#include "frozen/bits/exceptions.h"
+#include "frozen/bits/parallel.h"
+#include "frozen/bits/pmh.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+// Tag requesting a multi-threaded build of the dynamic_* containers.
+struct parallel_build {
+  unsigned threads = bits::default_thread_count();
+};
+
+namespace bits {
+
+// Maps the top-level hash of a key to its shard. The hash is scrambled by a
+// multiplication first, its lowest bits also select the slot in the shard.
+inline std::size_t pmh_shard_of(std::size_t hash, std::size_t shard_mask) {
+  return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> 40) & shard_mask;
+}
+
+// Perfect hash function built at runtime: the same G and H tables as
+// pmh_tables, with a number of slots chosen at construction. Large tables are
+// split in shards, selected by a top-level hash, and stored back to back.
+template <class Hasher>
+class dynamic_pmh_tables : private Hasher {
+  std::uint64_t shard_seed_ = 0;
+  std::size_t shard_mask_ = 0;
+  std::vector<pmh_shard> shards_;
+  std::vector<seed_or_index> first_table_;
+  std::vector<std::size_t> second_table_;
+
+public:
+  dynamic_pmh_tables(std::uint64_t shard_seed,
+                     std::vector<pmh_shard> shards,
+                     std::vector<seed_or_index> first_table,
+                     std::vector<std::size_t> second_table,
+                     Hasher const &hash)
+    : Hasher(hash)
+    , shard_seed_(shard_seed)
+    , shard_mask_(shards.size() - 1)
+    , shards_(std::move(shards))
+    , first_table_(std::move(first_table))
+    , second_table_(std::move(second_table))
+  {}
+
+  Hasher const& hash_function() const noexcept {
+    return static_cast<Hasher const&>(*this);
+  }
+
+  std::size_t size() const noexcept { return first_table_.size(); }
+  std::uint64_t shard_seed() const noexcept { return shard_seed_; }
+  std::vector<pmh_shard> const& shards() const noexcept { return shards_; }
+  std::vector<seed_or_index> const& first_table() const noexcept { return first_table_; }
+  std::vector<std::size_t> const& second_table() const noexcept { return second_table_; }
+
+  template <typename KeyType>
+  std::size_t lookup(const KeyType & key) const {
+    return lookup(key, hash_function());
+  }
+
+  template <typename KeyType, typename HasherType>
+  std::size_t lookup(const KeyType & key, const HasherType& hasher) const {
+    pmh_shard const *shard = shards_.data();
+    if (shard_mask_)
+      shard += pmh_shard_of(hasher(key, static_cast<std::size_t>(shard_seed_)), shard_mask_);
+    return pmh_lookup(key, hasher, shard->first_seed,
+                      first_table_.data() + shard->offset,
+                      second_table_.data() + shard->offset, shard->mask);
+  }
+
+  template <typename KeyIt, typename HasherType>
+  void lookup_batch(KeyIt keys, std::size_t count, const HasherType& hasher, std::size_t *indices) const {
+    pmh_lookup_batch(keys, count, hasher,
+                     [this, &hasher](decltype(*keys) key) -> pmh_shard const & {
+                       return shards_[shard_mask_ ? pmh_shard_of(hasher(key, static_cast<std::size_t>(shard_seed_)), shard_mask_) : 0];
+                     },
+                     first_table_.data(), second_table_.data(), indices);
+  }
+};
+
+// Runtime counterpart of make_pmh_tables, over the `count` items designated
+// by `index(0)` ... `index(count - 1)`, and `M` slots. Fills the M entries of
+// `G` and `H` with indices in `items`, `unused` for an empty slot. Buckets are
+// stored contiguously, as a list of item indices ordered by bucket, instead of
+// fixed capacity vectors.
+// Returns false if two of the items have the same key.
+template <class Items, class Index, class Hash, class Key, class KeyEqual, class PRG>
+bool build_pmh_slots(Items const &items, std::size_t count, Index const &index,
+                     std::size_t M, Hash const &hash, KeyEqual const &equal,
+                     Key const &key, PRG &prg, std::uint64_t &first_seed,
+                     seed_or_index *G, std::size_t *H, std::size_t unused) {
+  std::size_t const bucket_max = 2 * (std::size_t(1) << (log(M) / 2));
+
+  // Step 1: Place all of the keys into buckets
+  std::vector<std::size_t> bucket_of(count);
+  std::vector<std::size_t> bucket_start(M + 1);
+  while (true) {
+    first_seed = prg();
+    std::fill(bucket_start.begin(), bucket_start.end(), 0);
+    bool rejected = false;
+    for (std::size_t i = 0; i < count && !rejected; ++i) {
+      bucket_of[i] = hash(key(items[index(i)]), static_cast<std::size_t>(first_seed)) % M;
+      rejected = ++bucket_start[bucket_of[i] + 1] > bucket_max;
+    }
+    if (!rejected)
+      break;
+  }
+  for (std::size_t b = 0; b < M; ++b)
+    bucket_start[b + 1] += bucket_start[b];
+  std::vector<std::size_t> bucket_items(count);
+  {
+    std::vector<std::size_t> fill(bucket_start.begin(), bucket_start.end() - 1);
+    for (std::size_t i = 0; i < count; ++i)
+      bucket_items[fill[bucket_of[i]]++] = index(i);
+  }
+
+  // Step 1.5: Detect redundant keys.
+  for (std::size_t b = 0; b < M; ++b)
+    for (std::size_t i = bucket_start[b]; i < bucket_start[b + 1]; ++i)
+      for (std::size_t j = bucket_start[b]; j < i; ++j)
+        if (equal(key(items[bucket_items[i]]), key(items[bucket_items[j]])))
+          return false;
+
+  // Step 2: Sort the buckets to process the ones with the most items first.
+  // Sizes are bounded by bucket_max, a counting sort does the job.
+  std::vector<std::size_t> buckets(M);
+  {
+    std::vector<std::size_t> by_size(bucket_max + 2);
+    for (std::size_t b = 0; b < M; ++b)
+      by_size[bucket_max - (bucket_start[b + 1] - bucket_start[b]) + 1] += 1;
+    for (std::size_t s = 1; s < by_size.size(); ++s)
+      by_size[s] += by_size[s - 1];
+    for (std::size_t b = 0; b < M; ++b)
+      buckets[by_size[bucket_max - (bucket_start[b + 1] - bucket_start[b])]++] = b;
+  }
+
+  // G becomes the first hash table in the resulting pmh function
+  std::fill(G, G + M, seed_or_index{false, unused});
+
+  // H becomes the second hash table in the resulting pmh function
+  std::fill(H, H + M, unused);
+
+  // Step 3: Map the items in buckets into hash tables.
+  std::vector<std::size_t> bucket_slots;
+  bucket_slots.reserve(bucket_max);
+  for (auto const bucket : buckets) {
+    auto const first = bucket_items.begin() + bucket_start[bucket];
+    auto const bsize = bucket_start[bucket + 1] - bucket_start[bucket];
+
+    if (bsize == 1) {
+      // Store index to the (single) item in G
+      G[bucket] = {false, static_cast<std::uint64_t>(first[0])};
+    } else if (bsize > 1) {
+
+      // Repeatedly try different H of d until we find a hash function
+      // that places all items in the bucket into free slots
+      seed_or_index d{true, prg()};
+      bucket_slots.clear();
+
+      while (bucket_slots.size() < bsize) {
+        auto slot = hash(key(items[first[bucket_slots.size()]]), static_cast<std::size_t>(d.value())) % M;
+
+        if (H[slot] != unused || std::find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end()) {
+          bucket_slots.clear();
+          d = {true, prg()};
+          continue;
+        }
+
+        bucket_slots.push_back(slot);
+      }
+
+      // Put successful seed in G, and put indices to items in their slots
+      G[bucket] = d;
+      for (std::size_t i = 0; i < bsize; ++i)
+        H[bucket_slots[i]] = first[i];
+    }
+  }
+
+  return true;
+}
+
+struct identity_index {
+  std::size_t operator()(std::size_t i) const { return i; }
+};
+
+struct indirect_index {
+  std::size_t const *indices;
+  std::size_t operator()(std::size_t i) const { return indices[i]; }
+};
+
+// Builds a single shard perfect hash function over `items`, with `M` slots.
+template <class Items, class Hash, class Key, class KeyEqual, class PRG>
+dynamic_pmh_tables<Hash> make_dynamic_pmh_tables(Items const &items,
+                                                 std::size_t M,
+                                                 Hash const &hash,
+                                                 KeyEqual const &equal,
+                                                 Key const &key,
+                                                 PRG prg) {
+  std::vector<seed_or_index> G(M);
+  std::vector<std::size_t> H(M);
+  std::vector<pmh_shard> shards{{0, 0, M - 1}};
+  if (!build_pmh_slots(items, items.size(), identity_index{}, M, hash, equal,
+                       key, prg, shards[0].first_seed, G.data(), H.data(),
+                       items.size()))
+    FROZEN_THROW_OR_ABORT(std::invalid_argument("structure keys should be unique"));
+  return {0, std::move(shards), std::move(G), std::move(H), hash};
+}
+
+// Average number of items per shard of make_sharded_pmh_tables: large enough
+// for the shard table to stay small, small enough for shards to fit in cache
+// and to balance across threads.
+constexpr std::size_t pmh_shard_items = 2048;
+
+// Builds a sharded perfect hash function over `items` on `threads` threads.
+// Items are dispatched to shards by a top-level hash, then each shard is
+// built independently, with its own pseudo random generator so that the
+// result does not depend on the number of threads.
+template <class Items, class Hash, class Key, class KeyEqual, class PRG>
+dynamic_pmh_tables<Hash> make_sharded_pmh_tables(Items const &items,
+                                                 Hash const &hash,
+                                                 KeyEqual const &equal,
+                                                 Key const &key,
+                                                 PRG prg,
+                                                 unsigned threads) {
+  std::size_t const N = items.size();
+  std::size_t const S = N < 2 * pmh_shard_items
+                            ? 1
+                            : next_highest_power_of_two(N / pmh_shard_items);
+  if (S == 1)
+    return make_dynamic_pmh_tables(items, pmh_storage_size(N), hash, equal, key, prg);
+
+  // Step 1: Dispatch items to shards, the top-level hashes are computed in
+  // parallel, by blocks of items.
+  std::uint64_t const shard_seed = prg();
+  std::vector<std::uint32_t> shard_of(N);
+  std::size_t const block = 1 << 16;
+  parallel_for((N + block - 1) / block, threads, [&](std::size_t b) {
+    for (std::size_t i = b * block, e = std::min(N, i + block); i < e; ++i)
+      shard_of[i] = static_cast<std::uint32_t>(pmh_shard_of(
+          hash(key(items[i]), static_cast<std::size_t>(shard_seed)), S - 1));
+  });
+
+  std::vector<std::size_t> shard_start(S + 1);
+  for (std::size_t i = 0; i < N; ++i)
+    shard_start[shard_of[i] + 1] += 1;
+
+  std::vector<pmh_shard> shards(S);
+  std::size_t slots = 0;
+  for (std::size_t s = 0; s < S; ++s) {
+    auto const M = pmh_storage_size(shard_start[s + 1]);
+    shards[s] = {prg(), slots, M - 1};
+    slots += M;
+    shard_start[s + 1] += shard_start[s];
+  }
+
+  std::vector<std::size_t> shard_items(N);
+  {
+    std::vector<std::size_t> fill(shard_start.begin(), shard_start.end() - 1);
+    for (std::size_t i = 0; i < N; ++i)
+      shard_items[fill[shard_of[i]]++] = i;
+  }
+
+  // Step 2: Build each shard in its own slice of G and H.
+  std::vector<seed_or_index> G(slots);
+  std::vector<std::size_t> H(slots);
+  std::atomic<bool> unique{true};
+  parallel_for(S, threads, [&](std::size_t s) {
+    PRG shard_prg{static_cast<typename PRG::result_type>(shards[s].first_seed)};
+    if (!build_pmh_slots(items, shard_start[s + 1] - shard_start[s],
+                         indirect_index{shard_items.data() + shard_start[s]},
+                         shards[s].mask + 1, hash, equal, key, shard_prg,
+                         shards[s].first_seed, G.data() + shards[s].offset,
+                         H.data() + shards[s].offset, N))
+      unique.store(false, std::memory_order_relaxed);
+  });
+  if (!unique.load())
+    FROZEN_THROW_OR_ABORT(std::invalid_argument("structure keys should be unique"));
+
+  return {shard_seed, std::move(shards), std::move(G), std::move(H), hash};
+}
+
+// Number of seeds tried for a bucket by patch_pmh_slots before giving up.
+constexpr std::size_t pmh_patch_attempts = std::size_t(1) << 20;
+
+// Places the items `added` (indices in `items`, not in the tables yet) in the
+// existing G and H tables. Only the buckets that receive an item are
+// rebuilt: their current items are collected by scanning the H slots of their
+// shard, then a new seed is searched for each of them.
+// Returns false when a bucket cannot be placed, leaving G and H in an
+// unspecified state.
+template <class Items, class Hash, class Key, class KeyEqual, class PRG>
+bool patch_pmh_slots(Items const &items, std::vector<std::size_t> const &added,
+                     Hash const &hash, KeyEqual const &equal, Key const &key,
+                     PRG &prg, std::uint64_t shard_seed,
+                     std::vector<pmh_shard> const &shards,
+                     std::vector<seed_or_index> &first_table,
+                     std::vector<std::size_t> &second_table) {
+  std::size_t const N = items.size();
+  std::size_t const shard_mask = shards.size() - 1;
+
+  // Step 1: Group the new items by shard.
+  std::vector<std::pair<std::size_t, std::size_t>> by_shard; // (shard, item)
+  by_shard.reserve(added.size());
+  for (auto const i : added)
+    by_shard.emplace_back(shard_mask ? pmh_shard_of(hash(key(items[i]), static_cast<std::size_t>(shard_seed)), shard_mask) : 0, i);
+  std::sort(by_shard.begin(), by_shard.end());
+
+  std::vector<std::pair<std::size_t, std::size_t>> members; // (bucket, item)
+  std::vector<std::size_t> bucket_slots;
+  for (auto group = by_shard.begin(); group != by_shard.end();) {
+    pmh_shard const &shard = shards[group->first];
+    std::size_t const M = shard.mask + 1;
+    seed_or_index *const G = first_table.data() + shard.offset;
+    std::size_t *const H = second_table.data() + shard.offset;
+    auto const bucket_of = [&](std::size_t i) {
+      return hash(key(items[i]), static_cast<std::size_t>(shard.first_seed)) & shard.mask;
+    };
+
+    // Step 2: Collect the items of the buckets that change.
+    members.clear();
+    std::vector<bool> changed(M);
+    for (; group != by_shard.end() && &shards[group->first] == &shard; ++group) {
+      auto const bucket = bucket_of(group->second);
+      changed[bucket] = true;
+      members.emplace_back(bucket, group->second);
+    }
+    std::size_t used = members.size();
+    for (std::size_t slot = 0; slot < M; ++slot) {
+      if (H[slot] != N) {
+        ++used;
+        auto const bucket = bucket_of(H[slot]);
+        if (changed[bucket]) {
+          members.emplace_back(bucket, H[slot]);
+          H[slot] = N;
+        }
+      }
+      if (!G[slot].is_seed() && G[slot].value() != N) {
+        ++used;
+        if (changed[slot])
+          members.emplace_back(slot, static_cast<std::size_t>(G[slot].value()));
+      }
+      if (changed[slot])
+        G[slot] = {false, N};
+    }
+    if (used > M)
+      return false;
+
+    // Step 3: Sort the buckets to process the ones with the most items first,
+    // and place them as make_pmh_tables does.
+    std::sort(members.begin(), members.end());
+    std::vector<std::pair<std::size_t, std::size_t>> buckets; // (size, start)
+    for (std::size_t start = 0, end; start < members.size(); start = end) {
+      for (end = start + 1; end < members.size() && members[end].first == members[start].first; ++end)
+        for (std::size_t other = start; other < end; ++other)
+          if (equal(key(items[members[end].second]), key(items[members[other].second])))
+            FROZEN_THROW_OR_ABORT(std::invalid_argument("structure keys should be unique"));
+      buckets.emplace_back(end - start, start);
+    }
+    std::sort(buckets.begin(), buckets.end(), [](std::pair<std::size_t, std::size_t> const &lhs,
+                                                 std::pair<std::size_t, std::size_t> const &rhs) {
+      return lhs.first > rhs.first;
+    });
+
+    for (auto const &bucket : buckets) {
+      auto const first = members.begin() + bucket.second;
+      auto const bsize = bucket.first;
+      if (bsize == 1) {
+        G[first->first] = {false, static_cast<std::uint64_t>(first->second)};
+        continue;
+      }
+
+      seed_or_index d{true, prg()};
+      bucket_slots.clear();
+      for (std::size_t attempts = 0; bucket_slots.size() < bsize;) {
+        auto slot = hash(key(items[first[bucket_slots.size()].second]), static_cast<std::size_t>(d.value())) & shard.mask;
+
+        if (H[slot] != N || std::find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end()) {
+          if (++attempts == pmh_patch_attempts)
+            return false;
+          bucket_slots.clear();
+          d = {true, prg()};
+          continue;
+        }
+
+        bucket_slots.push_back(slot);
+      }
+
+      G[first->first] = d;
+      for (std::size_t i = 0; i < bsize; ++i)
+        H[bucket_slots[i]] = first[i].second;
+    }
+  }
+  return true;
+}
+
+// Indices of the last item of each key in `items`, in increasing order, so
+// that a key inserted several times by a rebuild is inserted once, with its
+// last value. Items are grouped by hash, then compared within a group.
+template <class Items, class Hash, class Key, class KeyEqual>
+std::vector<std::size_t> pmh_last_of_each_key(Items const &items, Hash const &hash,
+                                              KeyEqual const &equal, Key const &key) {
+  std::vector<std::pair<std::size_t, std::size_t>> by_hash(items.size());
+  for (std::size_t i = 0; i < items.size(); ++i)
+    by_hash[i] = {hash(key(items[i]), 0), i};
+  std::sort(by_hash.begin(), by_hash.end());
+
+  std::vector<std::size_t> last;
+  for (std::size_t i = 0; i < by_hash.size(); ++i) {
+    bool superseded = false;
+    for (std::size_t j = i + 1; j < by_hash.size() && by_hash[j].first == by_hash[i].first && !superseded; ++j)
+      superseded = equal(key(items[by_hash[i].second]), key(items[by_hash[j].second]));
+    if (!superseded)
+      last.push_back(by_hash[i].second);
+  }
+  std::sort(last.begin(), last.end());
+  return last;
+}
+
+// Order in which rebuild_pmh_tables expects the items that are kept: the
+// holes left by the `removed` indices (sorted) among the first kept items are
+// filled, in order, by the kept items past them. Returns the (from, to) moves.
+inline std::vector<std::pair<std::size_t, std::size_t>>
+pmh_swap_fill(std::size_t previous_size, std::vector<std::size_t> const &removed) {
+  std::size_t const kept = previous_size - removed.size();
+  std::vector<std::pair<std::size_t, std::size_t>> moves;
+  auto hole = removed.begin();
+  auto tail = std::lower_bound(removed.begin(), removed.end(), kept);
+  for (std::size_t from = kept; hole != removed.end() && *hole < kept; ++from) {
+    if (tail != removed.end() && *tail == from) {
+      ++tail;
+      continue;
+    }
+    moves.emplace_back(from, *hole++);
+  }
+  return moves;
+}
+
+// Tables of `items`, derived from the `previous` tables of `previous_items`:
+// the previous items at the sorted indices `removed` are gone, the others are
+// kept in pmh_swap_fill order, and the items from `first_added` on are new.
+// Only the entries of removed and moved items are rewritten. Falls back to a
+// complete build if the new items cannot be placed in the previous tables.
+template <class Items, class Hash, class Key, class KeyEqual, class PRG>
+dynamic_pmh_tables<Hash> rebuild_pmh_tables(dynamic_pmh_tables<Hash> const &previous,
+                                            Items const &previous_items,
+                                            std::vector<std::size_t> const &removed,
+                                            Items const &items,
+                                            std::size_t first_added,
+                                            Hash const &hash,
+                                            KeyEqual const &equal,
+                                            Key const &key,
+                                            PRG prg) {
+  std::size_t const N = items.size();
+  std::size_t const previous_size = previous_items.size();
+  std::vector<pmh_shard> shards = previous.shards();
+  std::vector<seed_or_index> G = previous.first_table();
+  std::vector<std::size_t> H = previous.second_table();
+
+  // Step 1: Move the previous items to their new index, freeing the slots of
+  // the removed ones, then update the marker of unused slots.
+  auto const relocate = [&](std::size_t item, std::size_t index) {
+    auto const &k = key(previous_items[item]);
+    pmh_shard const *shard = shards.data();
+    if (shards.size() > 1)
+      shard += pmh_shard_of(hash(k, static_cast<std::size_t>(previous.shard_seed())), shards.size() - 1);
+    auto &d = G[shard->offset + (hash(k, static_cast<std::size_t>(shard->first_seed)) & shard->mask)];
+    if (!d.is_seed())
+      d = {false, index};
+    else
+      H[shard->offset + (hash(k, static_cast<std::size_t>(d.value())) & shard->mask)] = index;
+  };
+  for (auto const item : removed)
+    relocate(item, previous_size);
+  for (auto const &move : pmh_swap_fill(previous_size, removed))
+    relocate(move.first, move.second);
+  if (N != previous_size) {
+    for (auto &entry : G)
+      if (!entry.is_seed() && entry.value() == previous_size)
+        entry = {false, N};
+    std::replace(H.begin(), H.end(), previous_size, N);
+  }
+
+  // Step 2: Place the new items.
+  std::vector<std::size_t> added(N - first_added);
+  for (std::size_t i = first_added; i < N; ++i)
+    added[i - first_added] = i;
+  if (added.empty() ||
+      patch_pmh_slots(items, added, hash, equal, key, prg, previous.shard_seed(), shards, G, H))
+    return {previous.shard_seed(), std::move(shards), std::move(G), std::move(H), previous.hash_function()};
+
+  if (shards.size() > 1)
+    return make_sharded_pmh_tables(items, hash, equal, key, prg, default_thread_count());
+  return make_dynamic_pmh_tables(items, pmh_storage_size(N), hash, equal, key, prg);
+}
+
+} // namespace bits
+
+} // namespace frozen
+
+#endif
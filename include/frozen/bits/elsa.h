@@ -23,6 +23,8 @@
 #ifndef FROZEN_LETITGO_ELSA_H
 #define FROZEN_LETITGO_ELSA_H
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace frozen {
@@ -52,6 +54,23 @@ template <> struct elsa<void> {
 };
 
 template <class T=void> using anna = elsa<T>;
+
+namespace bits {
+
+// Seeded hasher that ignores the key it is given and derives every hash from
+// the precomputed base hash of that key, for the find_hashed lookups.
+// Hash::combine(base, seed) must equal Hash{}(key, seed).
+template <class Hash> struct prehashed {
+  Hash const &hash;
+  std::uint64_t base;
+
+  template <class Key>
+  constexpr std::size_t operator()(Key const &, std::size_t seed) const {
+    return hash.combine(base, seed);
+  }
+};
+
+} // namespace bits
 } // namespace frozen
 
 #endif
@@ -32,6 +32,7 @@
 
 #include <stdexcept>
 #define FROZEN_THROW_OR_ABORT(err) throw err
+#define FROZEN_LETITGO_HAS_EXCEPTIONS
 
 
 #endif
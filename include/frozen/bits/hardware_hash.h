@@ -0,0 +1,364 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_BITS_HARDWARE_HASH_H
+#define FROZEN_LETITGO_BITS_HARDWARE_HASH_H
+
+#include "frozen/bits/basic_types.h"
+#include "frozen/bits/defines.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// The instructions are used at runtime only, when the compiler tells constant
+// evaluation apart, and when the target supports them: always if they are
+// enabled for the whole translation unit, otherwise after a CPU check, on
+// x86-64 with GCC or Clang.
+#if defined(FROZEN_LETITGO_HAS_IS_CONSTANT_EVALUATED) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FROZEN_LETITGO_HAS_CRC32C
+#define FROZEN_LETITGO_HAS_AESENC
+#if defined(__SSE4_2__)
+#define FROZEN_LETITGO_CRC32C_TARGET
+#define FROZEN_LETITGO_CRC32C_SUPPORTED() true
+#else
+#define FROZEN_LETITGO_CRC32C_TARGET __attribute__((target("sse4.2")))
+#define FROZEN_LETITGO_CRC32C_SUPPORTED() __builtin_cpu_supports("sse4.2")
+#endif
+#if defined(__AES__)
+#define FROZEN_LETITGO_AESENC_TARGET
+#define FROZEN_LETITGO_AESENC_SUPPORTED() true
+#else
+#define FROZEN_LETITGO_AESENC_TARGET __attribute__((target("aes")))
+#define FROZEN_LETITGO_AESENC_SUPPORTED() __builtin_cpu_supports("aes")
+#endif
+#elif defined(FROZEN_LETITGO_HAS_IS_CONSTANT_EVALUATED) && defined(__aarch64__) && \
+    defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define FROZEN_LETITGO_HAS_CRC32C
+#define FROZEN_LETITGO_CRC32C_TARGET
+#define FROZEN_LETITGO_CRC32C_SUPPORTED() true
+#endif
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#define FROZEN_LETITGO_HAS_AESENC
+#define FROZEN_LETITGO_AESENC_TARGET
+#define FROZEN_LETITGO_AESENC_SUPPORTED() true
+#endif
+#endif
+
+namespace frozen {
+
+namespace bits {
+
+// Software versions of the CRC32C and AES round instructions, bit for bit, so
+// that tables built at compile time agree with lookups hashed by the
+// instructions at runtime.
+
+// A 128-bit AES state, bytes 0 to 7 in lo, lowest first, then hi.
+struct aes_block {
+  std::uint64_t lo;
+  std::uint64_t hi;
+};
+
+constexpr std::uint32_t crc32c_entry(std::uint32_t value) {
+  for (int bit = 0; bit < 8; ++bit)
+    value = (value & 1) ? (value >> 1) ^ 0x82F63B78u : value >> 1;
+  return value;
+}
+
+template <std::size_t... Is>
+constexpr carray<std::uint32_t, 256> make_crc32c_table(std::index_sequence<Is...>) {
+  return {crc32c_entry(static_cast<std::uint32_t>(Is))...};
+}
+
+template <class = void> struct hardware_hash_tables {
+  static constexpr carray<std::uint32_t, 256> crc32c = make_crc32c_table(std::make_index_sequence<256>{});
+  static constexpr std::uint8_t sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+  };
+  // Round keys of aes_hash: digits of pi.
+  static constexpr aes_block aes_keys[3] = {{0x243F6A8885A308D3ull, 0x13198A2E03707344ull},
+                                            {0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull},
+                                            {0x452821E638D01377ull, 0xBE5466CF34E90C6Cull}};
+};
+template <class T> constexpr carray<std::uint32_t, 256> hardware_hash_tables<T>::crc32c;
+template <class T> constexpr std::uint8_t hardware_hash_tables<T>::sbox[256];
+template <class T> constexpr aes_block hardware_hash_tables<T>::aes_keys[3];
+
+// _mm_crc32_u64 and __crc32cd: the reflected CRC32C of the 8 bytes of
+// `value`, lowest first, continued from `crc`, with no inversion.
+constexpr std::uint32_t crc32c_u64_soft(std::uint32_t crc, std::uint64_t value) {
+  for (int byte = 0; byte < 8; ++byte) {
+    crc = hardware_hash_tables<>::crc32c[(crc ^ value) & 0xFF] ^ (crc >> 8);
+    value >>= 8;
+  }
+  return crc;
+}
+
+constexpr std::uint8_t aes_byte(aes_block const &block, std::size_t i) {
+  return static_cast<std::uint8_t>((i < 8 ? block.lo >> (8 * i) : block.hi >> (8 * (i - 8))) & 0xFF);
+}
+
+constexpr std::uint8_t aes_xtime(std::uint8_t value) {
+  return static_cast<std::uint8_t>((value << 1) ^ ((value & 0x80) ? 0x1B : 0));
+}
+
+// _mm_aesenc_si128: ShiftRows, SubBytes, MixColumns, then AddRoundKey.
+constexpr aes_block aesenc_soft(aes_block state, aes_block key) {
+  aes_block result{0, 0};
+  for (std::size_t column = 0; column < 4; ++column) {
+    std::uint8_t a[4] = {};
+    for (std::size_t row = 0; row < 4; ++row)
+      a[row] = hardware_hash_tables<>::sbox[aes_byte(state, row + 4 * ((column + row) % 4))];
+    std::uint8_t const all = static_cast<std::uint8_t>(a[0] ^ a[1] ^ a[2] ^ a[3]);
+    std::uint64_t mixed = 0;
+    for (std::size_t row = 0; row < 4; ++row) {
+      // 2 * a[row] + 3 * a[row + 1] + a[row + 2] + a[row + 3]
+      auto const b = all ^ a[row] ^ aes_xtime(static_cast<std::uint8_t>(a[row] ^ a[(row + 1) % 4]));
+      mixed |= std::uint64_t(b & 0xFF) << (8 * row);
+    }
+    if (column < 2)
+      result.lo |= mixed << (32 * column);
+    else
+      result.hi |= mixed << (32 * (column - 2));
+  }
+  return {result.lo ^ key.lo, result.hi ^ key.hi};
+}
+
+// Characters [first, first + count) of `data` packed in a word, lowest
+// first, each as wide as CharT: the bytes of the characters on a little
+// endian target.
+template <class CharT>
+constexpr std::uint64_t hash_word(CharT const *data, std::size_t first, std::size_t count) {
+  using unsigned_t = typename std::make_unsigned<CharT>::type;
+  std::uint64_t word = 0;
+  for (std::size_t i = 0; i < count; ++i)
+    word |= std::uint64_t(static_cast<unsigned_t>(data[first + i])) << (8 * sizeof(CharT) * i);
+  return word;
+}
+
+template <class CharT> struct hash_words {
+  static_assert(sizeof(std::uint64_t) % sizeof(CharT) == 0, "characters must pack in 64-bit words");
+  static constexpr std::size_t per_word = sizeof(std::uint64_t) / sizeof(CharT);
+};
+
+// The string hashes: CRC32C of the characters, a word at a time, the last
+// one padded with zeros, then of the length, which tells apart keys that
+// only differ by trailing zeros. For AES, the state absorbs 16 bytes at a
+// time, xored into it before one round, then goes through two more rounds.
+
+// crc_hash runs two CRC32C lanes over the same words, each word multiplied
+// first by an odd factor of the lane, both drawn from the seed. The CRC is
+// linear in the words and in its initial value, so two keys with the same CRC
+// would collide for every seed if the seed only went in the initial value or
+// were xored into the words; the multiplication is not linear, and moves the
+// collisions with the seed. The lanes together give 64 bits.
+struct crc_state {
+  std::uint64_t factor_lo;
+  std::uint64_t factor_hi;
+  std::uint32_t lo;
+  std::uint32_t hi;
+};
+
+constexpr crc_state crc_start(std::uint64_t seed) {
+  return {(seed * 0x9E3779B97F4A7C15ull) | 1, ((seed ^ 0xC2B2AE3D27D4EB4Full) * 0xFF51AFD7ED558CCDull) | 1,
+          static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+}
+
+constexpr std::uint64_t crc_finish(crc_state state) {
+  std::uint64_t const mixed = (std::uint64_t(state.hi) << 32 | state.lo) * 0x9E3779B97F4A7C15ull;
+  return mixed ^ (mixed >> 32);
+}
+
+constexpr crc_state crc_step_soft(crc_state state, std::uint64_t word) {
+  return {state.factor_lo, state.factor_hi, crc32c_u64_soft(state.lo, word * state.factor_lo),
+          crc32c_u64_soft(state.hi, word * state.factor_hi)};
+}
+
+template <class CharT>
+constexpr crc_state crc_string_soft(crc_state state, CharT const *data, std::size_t size) {
+  constexpr std::size_t per_word = hash_words<CharT>::per_word;
+  std::size_t i = 0;
+  for (; i + per_word <= size; i += per_word)
+    state = crc_step_soft(state, hash_word(data, i, per_word));
+  if (i < size)
+    state = crc_step_soft(state, hash_word(data, i, size - i));
+  return crc_step_soft(state, size);
+}
+
+constexpr std::uint64_t aes_finish_soft(aes_block state) {
+  state = aesenc_soft(state, hardware_hash_tables<>::aes_keys[1]);
+  state = aesenc_soft(state, hardware_hash_tables<>::aes_keys[2]);
+  return state.lo ^ state.hi;
+}
+
+template <class CharT>
+constexpr std::uint64_t aes_string_soft(aes_block state, CharT const *data, std::size_t size) {
+  constexpr std::size_t per_word = hash_words<CharT>::per_word;
+  auto const key = hardware_hash_tables<>::aes_keys[0];
+  std::size_t i = 0;
+  for (; i + 2 * per_word <= size; i += 2 * per_word)
+    state = aesenc_soft({state.lo ^ hash_word(data, i, per_word), state.hi ^ hash_word(data, i + per_word, per_word)},
+                        key);
+  if (i < size) {
+    std::size_t const low = size - i < per_word ? size - i : per_word;
+    state = aesenc_soft({state.lo ^ hash_word(data, i, low), state.hi ^ hash_word(data, i + low, size - i - low)},
+                        key);
+  }
+  return aes_finish_soft(state);
+}
+
+// Same functions with the instructions. A whole hash is computed with them
+// enabled, as a call to a function of another target is not inlined.
+
+#ifdef FROZEN_LETITGO_HAS_CRC32C
+FROZEN_LETITGO_CRC32C_TARGET inline std::uint32_t crc32c_u64_hard(std::uint32_t crc, std::uint64_t value) {
+#if defined(__x86_64__)
+  return static_cast<std::uint32_t>(_mm_crc32_u64(crc, value));
+#else
+  return __crc32cd(crc, value);
+#endif
+}
+
+FROZEN_LETITGO_CRC32C_TARGET inline crc_state crc_step_hard(crc_state state, std::uint64_t word) {
+  return {state.factor_lo, state.factor_hi, crc32c_u64_hard(state.lo, word * state.factor_lo),
+          crc32c_u64_hard(state.hi, word * state.factor_hi)};
+}
+
+template <class CharT>
+FROZEN_LETITGO_CRC32C_TARGET crc_state crc_string_hard(crc_state state, CharT const *data, std::size_t size) {
+  constexpr std::size_t per_word = hash_words<CharT>::per_word;
+  std::size_t i = 0;
+  for (; i + per_word <= size; i += per_word) {
+    std::uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    state = crc_step_hard(state, word);
+  }
+  if (i < size)
+    state = crc_step_hard(state, hash_word(data, i, size - i));
+  return crc_step_hard(state, size);
+}
+#endif
+
+#ifdef FROZEN_LETITGO_HAS_AESENC
+FROZEN_LETITGO_AESENC_TARGET inline aes_block aesenc_hard(aes_block state, aes_block key) {
+#if defined(__x86_64__)
+  // Moved to the vector unit a word at a time: storing both then loading
+  // them as one block defeats store forwarding.
+  __m128i const block = _mm_unpacklo_epi64(_mm_cvtsi64_si128(static_cast<long long>(state.lo)),
+                                           _mm_cvtsi64_si128(static_cast<long long>(state.hi)));
+  __m128i const result =
+      _mm_aesenc_si128(block, _mm_set_epi64x(static_cast<long long>(key.hi), static_cast<long long>(key.lo)));
+  return {static_cast<std::uint64_t>(_mm_cvtsi128_si64(result)),
+          static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(result, result)))};
+#else
+  uint8x16_t const block = vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(state.lo), vcreate_u64(state.hi)));
+  uint64x2_t const result = vreinterpretq_u64_u8(vaesmcq_u8(vaeseq_u8(block, vdupq_n_u8(0))));
+  return {vgetq_lane_u64(result, 0) ^ key.lo, vgetq_lane_u64(result, 1) ^ key.hi};
+#endif
+}
+
+FROZEN_LETITGO_AESENC_TARGET inline std::uint64_t aes_finish_hard(aes_block state) {
+  state = aesenc_hard(state, hardware_hash_tables<>::aes_keys[1]);
+  state = aesenc_hard(state, hardware_hash_tables<>::aes_keys[2]);
+  return state.lo ^ state.hi;
+}
+
+template <class CharT>
+FROZEN_LETITGO_AESENC_TARGET std::uint64_t aes_string_hard(aes_block state, CharT const *data, std::size_t size) {
+  constexpr std::size_t per_word = hash_words<CharT>::per_word;
+  auto const key = hardware_hash_tables<>::aes_keys[0];
+  std::size_t i = 0;
+  for (; i + 2 * per_word <= size; i += 2 * per_word) {
+    std::uint64_t words[2];
+    std::memcpy(words, data + i, sizeof(words));
+    state = aesenc_hard({state.lo ^ words[0], state.hi ^ words[1]}, key);
+  }
+  if (i < size) {
+    std::size_t const low = size - i < per_word ? size - i : per_word;
+    state = aesenc_hard({state.lo ^ hash_word(data, i, low), state.hi ^ hash_word(data, i + low, size - i - low)},
+                        key);
+  }
+  return aes_finish_hard(state);
+}
+#endif
+
+constexpr crc_state crc_step(crc_state state, std::uint64_t word) {
+#ifdef FROZEN_LETITGO_HAS_CRC32C
+  if (!__builtin_is_constant_evaluated() && FROZEN_LETITGO_CRC32C_SUPPORTED())
+    return crc_step_hard(state, word);
+#endif
+  return crc_step_soft(state, word);
+}
+
+template <class CharT>
+constexpr crc_state crc_string(crc_state state, CharT const *data, std::size_t size) {
+#ifdef FROZEN_LETITGO_HAS_CRC32C
+  if (!__builtin_is_constant_evaluated() && FROZEN_LETITGO_CRC32C_SUPPORTED())
+    return crc_string_hard(state, data, size);
+#endif
+  return crc_string_soft(state, data, size);
+}
+
+constexpr std::uint64_t aes_finish(aes_block state) {
+#ifdef FROZEN_LETITGO_HAS_AESENC
+  if (!__builtin_is_constant_evaluated() && FROZEN_LETITGO_AESENC_SUPPORTED())
+    return aes_finish_hard(state);
+#endif
+  return aes_finish_soft(state);
+}
+
+template <class CharT>
+constexpr std::uint64_t aes_string(aes_block state, CharT const *data, std::size_t size) {
+#ifdef FROZEN_LETITGO_HAS_AESENC
+  if (!__builtin_is_constant_evaluated() && FROZEN_LETITGO_AESENC_SUPPORTED())
+    return aes_string_hard(state, data, size);
+#endif
+  return aes_string_soft(state, data, size);
+}
+
+} // namespace bits
+
+} // namespace frozen
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_BITS_PARALLEL_H
+#define FROZEN_LETITGO_BITS_PARALLEL_H
+
+#include "frozen/bits/exceptions.h"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace frozen {
+
+namespace bits {
+
+inline unsigned default_thread_count() {
+  unsigned const count = std::thread::hardware_concurrency();
+  return count ? count : 1;
+}
+
+// Runs `task(i)` for each i in [0, count) on at most `threads` threads, the
+// calling thread included. Tasks are handed out in increasing order of i, one
+// at a time, so that uneven tasks still balance. If a task throws, the tasks
+// not started yet are skipped, and the first exception is rethrown on the
+// calling thread once every thread has stopped. Threads that cannot be
+// started leave their share of the tasks to the others.
+template <class Task>
+void parallel_for(std::size_t count, unsigned threads, Task const &task) {
+  std::atomic<std::size_t> next{0};
+  std::mutex failure_lock;
+  std::exception_ptr failure;
+  auto worker = [&]() {
+#ifdef FROZEN_LETITGO_HAS_EXCEPTIONS
+    try {
+#endif
+      for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;)
+        task(i);
+#ifdef FROZEN_LETITGO_HAS_EXCEPTIONS
+    } catch (...) {
+      next.store(count, std::memory_order_relaxed);
+      std::lock_guard<std::mutex> guard(failure_lock);
+      if (!failure)
+        failure = std::current_exception();
+    }
+#endif
+  };
+
+  if (threads > count)
+    threads = static_cast<unsigned>(count);
+
+  std::vector<std::thread> pool;
+#ifdef FROZEN_LETITGO_HAS_EXCEPTIONS
+  try {
+#endif
+    pool.reserve(threads ? threads - 1 : 0);
+    for (unsigned t = 1; t < threads; ++t)
+      pool.emplace_back(worker);
+#ifdef FROZEN_LETITGO_HAS_EXCEPTIONS
+  } catch (std::exception const &) {
+    // Out of memory or threads: the threads started so far do the work.
+  }
+#endif
+  worker();
+  for (auto &thread : pool)
+    thread.join();
+  if (failure)
+    std::rethrow_exception(failure);
+}
+
+} // namespace bits
+
+} // namespace frozen
+
+#endif
@@ -26,11 +26,15 @@
 
 #include "frozen/bits/algorithms.h"
 #include "frozen/bits/basic_types.h"
+#include "frozen/bits/defines.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/exceptions.h"
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 namespace frozen {
 
@@ -90,16 +94,27 @@ struct pmh_buckets {
   }
 };
 
+// Work done by make_pmh_tables, a measure of how well a hasher suits a key set.
+struct pmh_build_stats {
+  // First level seeds drawn until no bucket exceeds bucket_max.
+  std::size_t first_seeds = 0;
+  // Second level seeds drawn, over all the buckets of several keys.
+  std::size_t second_seeds = 0;
+  std::size_t largest_bucket = 0;
+};
+
 template <std::size_t M, class Item, std::size_t N, class Hash, class Key, class PRG>
 pmh_buckets<M> constexpr make_pmh_buckets(const carray<Item, N> & items,
                                 Hash const & hash,
                                 Key const & key,
-                                PRG & prg) {
+                                PRG & prg,
+                                pmh_build_stats & stats) {
   using result_t = pmh_buckets<M>;
   // Continue until all items are placed without exceeding bucket_max
   while (1) {
     result_t result{};
     result.seed = prg();
+    ++stats.first_seeds;
     bool rejected = false;
     for (std::size_t i = 0; i < items.size(); ++i) {
       auto & bucket = result.buckets[hash(key(items[i]), static_cast<std::size_t>(result.seed)) % M];
@@ -113,6 +128,18 @@ pmh_buckets<M> constexpr make_pmh_buckets(const carray<Item, N> & items,
   }
 }
 
+// Equal keys share a bucket, and no seed tells them apart: without this
+// check, placing their bucket would never end.
+template <std::size_t M, class Item, std::size_t N, class Key, class KeyEqual>
+constexpr void check_unique_keys(pmh_buckets<M> const &step_one, const carray<Item, N> &items,
+                                 KeyEqual const &equal, Key const &key) {
+  for (auto const &bucket : step_one.buckets)
+    for (std::size_t i = 1; i < bucket.size(); ++i)
+      for (std::size_t j = 0; j < i; ++j)
+        if (equal(key(items[bucket[j]]), key(items[bucket[i]])))
+          FROZEN_THROW_OR_ABORT(std::invalid_argument("structure keys should be unique"));
+}
+
 // Check if an item appears in a cvector
 template<class T, std::size_t N>
 constexpr bool all_different_from(cvector<T, N> & data, T & a) {
@@ -146,9 +173,131 @@ public:
   constexpr seed_or_index & operator =(const seed_or_index &) = default;
 };
 
+// Number of slots of the tables built for N items: always a power of two, so
+// that reducing a hash to a slot is a mask.
+constexpr std::size_t pmh_storage_size(std::size_t N) {
+  return N ? next_highest_power_of_two(N) * (N < 32 ? 2 : 1) // size adjustment to prevent high collision rate for small sets
+           : 1;
+}
+
+// Looks up a given key in the G (first) and H (second) tables of a perfect
+// hash function with `mask + 1` slots, to find its expected index in the
+// item array. Always returns a valid index, or the number of items, must use
+// KeyEqual test after to confirm. Shared by all the table layouts.
+template <typename KeyType, typename HasherType, typename FirstTable, typename SecondTable>
+constexpr std::size_t pmh_lookup(const KeyType & key, const HasherType & hasher,
+                                 std::uint64_t first_seed, FirstTable const & first_table,
+                                 SecondTable const & second_table, std::size_t mask) {
+  auto const d = first_table[hasher(key, static_cast<std::size_t>(first_seed)) & mask];
+  if (!d.is_seed()) { return static_cast<std::size_t>(d.value()); } // this is narrowing std::uint64 -> std::size_t but should be fine
+  else { return second_table[hasher(key, static_cast<std::size_t>(d.value())) & mask]; }
+}
+
+// One independent perfect hash function, over `mask + 1` slots starting at
+// `offset` in the G and H tables.
+struct pmh_shard {
+  std::uint64_t first_seed;
+  std::size_t offset;
+  std::size_t mask;
+};
+
+// Number of keys looked up together by pmh_lookup_batch.
+constexpr std::size_t pmh_batch_size = 16;
+
+// Looks up the `count` keys starting at `keys`, at most pmh_batch_size, and
+// stores their expected index in `indices`, as pmh_lookup does. The lookups
+// are interleaved, so that the memory accesses of one key overlap with the
+// others: all first level slots are prefetched, then all second level ones.
+// `shard_of(key)` tells where the G and H tables of `key` are, as a
+// pmh_shard.
+template <typename KeyIt, typename HasherType, typename ShardOf, typename FirstTable, typename SecondTable>
+void pmh_lookup_batch(KeyIt keys, std::size_t count, const HasherType & hasher, ShardOf const & shard_of,
+                      FirstTable const & first_table, SecondTable const & second_table,
+                      std::size_t * indices) {
+  std::size_t slots[pmh_batch_size];
+  std::size_t offsets[pmh_batch_size];
+  std::size_t masks[pmh_batch_size];
+  bool seeded[pmh_batch_size];
+
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const shard = shard_of(keys[i]);
+    offsets[i] = static_cast<std::size_t>(shard.offset);
+    masks[i] = static_cast<std::size_t>(shard.mask);
+    slots[i] = offsets[i] + (hasher(keys[i], static_cast<std::size_t>(shard.first_seed)) & masks[i]);
+    FROZEN_LETITGO_PREFETCH(&first_table[slots[i]]);
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const d = first_table[slots[i]];
+    seeded[i] = d.is_seed();
+    if (!seeded[i]) {
+      indices[i] = static_cast<std::size_t>(d.value());
+    } else {
+      slots[i] = offsets[i] + (hasher(keys[i], static_cast<std::size_t>(d.value())) & masks[i]);
+      FROZEN_LETITGO_PREFETCH(&second_table[slots[i]]);
+    }
+  }
+  for (std::size_t i = 0; i < count; ++i)
+    if (seeded[i])
+      indices[i] = second_table[slots[i]];
+}
+
+// Gives the algorithms built on top of the perfect hash containers access to
+// their tables.
+struct pmh_access {
+  template <class Container>
+  static constexpr auto tables(Container const &container) -> decltype((container.tables_)) {
+    return container.tables_;
+  }
+};
+
+// Slot of item `i` in H for a given second level seed, as pmh_tables
+// computes it: the key hashed again with the seed.
+template <std::size_t M, class Item, std::size_t N, class Hash, class Key>
+struct pmh_rehash_slot {
+  carray<Item, N> const &items;
+  Hash const &hash;
+  Key const &key;
+
+  constexpr std::size_t operator()(std::size_t i, std::uint64_t seed) const {
+    return hash(key(items[i]), static_cast<std::size_t>(seed)) % M;
+  }
+};
+
+// Step 3 of make_pmh_tables for a bucket: repeatedly tries different seeds
+// until one places all the items of the bucket into free slots of H, then
+// puts the indices of the items in these slots. Returns the seed.
+// `slot_of(i, seed)` is the slot of item i for a seed, N marks free slots.
+template <std::size_t M, std::size_t N, class Bucket, class SlotOf, class PRG>
+constexpr std::uint64_t place_pmh_bucket(Bucket const &bucket, SlotOf const &slot_of, PRG &prg,
+                                         carray<std::size_t, M> &H, pmh_build_stats &stats) {
+  auto const bsize = bucket.size();
+  seed_or_index d{true, prg()};
+  ++stats.second_seeds;
+  cvector<std::size_t, pmh_buckets<M>::bucket_max> bucket_slots;
+
+  while (bucket_slots.size() < bsize) {
+    auto slot = slot_of(bucket[bucket_slots.size()], d.value());
+
+    if (H[slot] != N || !all_different_from(bucket_slots, slot)) {
+      bucket_slots.clear();
+      d = {true, prg()};
+      ++stats.second_seeds;
+      continue;
+    }
+
+    bucket_slots.push_back(slot);
+  }
+
+  for (std::size_t i = 0; i < bsize; ++i)
+    H[bucket_slots[i]] = bucket[i];
+  return d.value();
+}
+
 // Represents the perfect hash function created by pmh algorithm
 template <std::size_t M, class Hasher>
 struct pmh_tables : private Hasher {
+  static_assert((M & (M - 1)) == 0, "the number of slots must be a power of two");
+
   std::uint64_t first_seed_;
   carray<seed_or_index, M> first_table_;
   carray<std::size_t, M> second_table_;
@@ -177,30 +326,37 @@ struct pmh_tables : private Hasher {
   // Always returns a valid index, must use KeyEqual test after to confirm.
   template <typename KeyType, typename HasherType>
   constexpr std::size_t lookup(const KeyType & key, const HasherType& hasher) const {
-    auto const d = first_table_[hasher(key, static_cast<std::size_t>(first_seed_)) % M];
-    if (!d.is_seed()) { return static_cast<std::size_t>(d.value()); } // this is narrowing std::uint64 -> std::size_t but should be fine
-    else { return second_table_[hasher(key, static_cast<std::size_t>(d.value())) % M]; }
+    return pmh_lookup(key, hasher, first_seed_, first_table_, second_table_, M - 1);
+  }
+
+  template <typename KeyIt, typename HasherType>
+  void lookup_batch(KeyIt keys, std::size_t count, const HasherType& hasher, std::size_t *indices) const {
+    pmh_shard const shard{first_seed_, 0, M - 1};
+    pmh_lookup_batch(keys, count, hasher,
+                     [&shard](decltype(*keys)) -> pmh_shard const & { return shard; },
+                     first_table_, second_table_, indices);
   }
 };
 
-// Make pmh tables for given items, hash function, prg, etc.
+// Make pmh tables for given items, hash function, prg, etc. and record the
+// work done in `stats`.
 template <std::size_t M, class Item, std::size_t N, class Hash, class Key, class KeyEqual, class PRG>
 pmh_tables<M, Hash> constexpr make_pmh_tables(const carray<Item, N> &
                                                                items,
                                                            Hash const &hash,
                                                            KeyEqual const &equal,
                                                            Key const &key,
-                                                           PRG prg) {
+                                                           PRG prg,
+                                                           pmh_build_stats &stats) {
   // Step 1: Place all of the keys into buckets
-  auto step_one = make_pmh_buckets<M>(items, hash, key, prg);
+  auto step_one = make_pmh_buckets<M>(items, hash, key, prg, stats);
 
   // Step 1.5: Detect redundant keys.
-  for(auto const& bucket : step_one.buckets)
-    for(std::size_t i = 1; i < bucket.size(); ++i)
-      constexpr_assert(!equal(key(items[0]), key(items[i])), "structure keys should be unique");
+  check_unique_keys(step_one, items, equal, key);
 
   // Step 2: Sort the buckets to process the ones with the most items first.
   auto buckets = step_one.get_sorted_buckets();
+  stats.largest_bucket = buckets[0].size();
 
   // Special value for unused slots. This is purposefully the index
   // one-past-the-end of 'items' to function as a sentinel value. Both to avoid
@@ -224,35 +380,294 @@ pmh_tables<M, Hash> constexpr make_pmh_tables(const carray<Item, N> &
       // assert(bucket.hash == hash(key(items[bucket[0]]), step_one.seed) % M);
       G[bucket.hash] = {false, static_cast<std::uint64_t>(bucket[0])};
     } else if (bsize > 1) {
+      // Put successful seed in G, and put indices to items in their slots
+      // assert(bucket.hash == hash(key(items[bucket[0]]), step_one.seed) % M);
+      pmh_rehash_slot<M, Item, N, Hash, Key> const slot_of{items, hash, key};
+      G[bucket.hash] = {true, place_pmh_bucket<M, N>(bucket, slot_of, prg, H, stats)};
+    }
+  }
 
-      // Repeatedly try different H of d until we find a hash function
-      // that places all items in the bucket into free slots
-      seed_or_index d{true, prg()};
-      cvector<std::size_t, decltype(step_one)::bucket_max> bucket_slots;
+  return {step_one.seed, G, H, hash};
+}
 
-      while (bucket_slots.size() < bsize) {
-        auto slot = hash(key(items[bucket[bucket_slots.size()]]), static_cast<std::size_t>(d.value())) % M;
+template <std::size_t M, class Item, std::size_t N, class Hash, class Key, class KeyEqual, class PRG>
+pmh_tables<M, Hash> constexpr make_pmh_tables(const carray<Item, N> &items, Hash const &hash,
+                                              KeyEqual const &equal, Key const &key, PRG prg) {
+  pmh_build_stats stats;
+  return make_pmh_tables<M>(items, hash, equal, key, prg, stats);
+}
 
-        if (H[slot] != UNUSED || !all_different_from(bucket_slots, slot)) {
-          bucket_slots.clear();
-          d = {true, prg()};
-          continue;
-        }
+// Slot in H of a key whose first level hash is `hash`, for the multiplier
+// found in its slot of G: the top log(M) bits of their product. Multiply-shift
+// with a random odd multiplier is universal, so keys of a bucket, whose hashes
+// differ, go to different slots for some multiplier.
+template <std::size_t M>
+constexpr std::size_t pmh_multiply_slot(std::uint64_t hash, std::uint64_t multiplier) {
+  return M > 1 ? static_cast<std::size_t>((hash * multiplier) >> (64 - log(M))) : 0;
+}
 
-        bucket_slots.push_back(slot);
-      }
+template <std::size_t M, std::size_t N>
+struct pmh_multiply_slot_of {
+  carray<std::uint64_t, N> const &hashes;
 
-      // Put successful seed in G, and put indices to items in their slots
-      // assert(bucket.hash == hash(key(items[bucket[0]]), step_one.seed) % M);
-      G[bucket.hash] = d;
-      for (std::size_t i = 0; i < bsize; ++i)
-        H[bucket_slots[i]] = bucket[i];
+  constexpr std::size_t operator()(std::size_t i, std::uint64_t seed) const {
+    return pmh_multiply_slot<M>(hashes[i], seed | 1);
+  }
+};
+
+// Perfect hash tables where every used slot of G holds a multiplier, buckets
+// of a single item included, instead of a seed_or_index: lookups hash the key
+// once, then always multiply, shift and load from H, with no branch on the
+// kind of slot. That branch is unpredictable on random keys when buckets of
+// one and several items mix.
+template <std::size_t M, class Hasher>
+struct pmh_branchless_tables : private Hasher {
+  static_assert((M & (M - 1)) == 0, "the number of slots must be a power of two");
+
+  std::uint64_t first_seed_;
+  carray<std::uint64_t, M> first_table_;
+  carray<std::size_t, M> second_table_;
+
+  constexpr pmh_branchless_tables(
+      std::uint64_t first_seed,
+      carray<std::uint64_t, M> first_table,
+      carray<std::size_t, M> second_table,
+      Hasher hash) noexcept
+    : Hasher(hash)
+    , first_seed_(first_seed)
+    , first_table_(first_table)
+    , second_table_(second_table)
+  {}
+
+  constexpr Hasher const& hash_function() const noexcept {
+    return static_cast<Hasher const&>(*this);
+  }
+
+  template <typename KeyType>
+  constexpr std::size_t lookup(const KeyType & key) const {
+    return lookup(key, hash_function());
+  }
+
+  // Same as pmh_tables::lookup.
+  template <typename KeyType, typename HasherType>
+  constexpr std::size_t lookup(const KeyType & key, const HasherType& hasher) const {
+    std::uint64_t const hash = hasher(key, static_cast<std::size_t>(first_seed_));
+    return second_table_[pmh_multiply_slot<M>(hash, first_table_[hash & (M - 1)])];
+  }
+
+  // Same as pmh_lookup_batch.
+  template <typename KeyIt, typename HasherType>
+  void lookup_batch(KeyIt keys, std::size_t count, const HasherType& hasher, std::size_t *indices) const {
+    std::uint64_t hashes[pmh_batch_size];
+    std::size_t slots[pmh_batch_size];
+    for (std::size_t i = 0; i < count; ++i) {
+      hashes[i] = hasher(keys[i], static_cast<std::size_t>(first_seed_));
+      FROZEN_LETITGO_PREFETCH(&first_table_[hashes[i] & (M - 1)]);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      slots[i] = pmh_multiply_slot<M>(hashes[i], first_table_[hashes[i] & (M - 1)]);
+      FROZEN_LETITGO_PREFETCH(&second_table_[slots[i]]);
     }
+    for (std::size_t i = 0; i < count; ++i)
+      indices[i] = second_table_[slots[i]];
   }
+};
+
+// Same as make_pmh_tables, with multipliers for the buckets of a single item
+// too. Unused slots of G hold 0, which sends keys to the first slot of H:
+// unused or the index of another item, KeyEqual rejects them either way.
+// Keys whose first level hashes are equal cannot be told apart: the hasher
+// must not drop bits of the keys, as a 32-bit size_t may for 64-bit keys.
+template <std::size_t M, class Item, std::size_t N, class Hash, class Key, class KeyEqual, class PRG>
+pmh_branchless_tables<M, Hash> constexpr make_pmh_branchless_tables(const carray<Item, N> &items, Hash const &hash,
+                                                                    KeyEqual const &equal, Key const &key, PRG prg,
+                                                                    pmh_build_stats &stats) {
+  auto step_one = make_pmh_buckets<M>(items, hash, key, prg, stats);
+
+  check_unique_keys(step_one, items, equal, key);
+
+  auto buckets = step_one.get_sorted_buckets();
+  stats.largest_bucket = buckets[0].size();
+
+  carray<std::uint64_t, N> hashes{};
+  for (std::size_t i = 0; i < N; ++i)
+    hashes[i] = hash(key(items[i]), static_cast<std::size_t>(step_one.seed));
+
+  carray<std::uint64_t, M> G(0);
+  carray<std::size_t, M> H(items.size());
+
+  // Larger buckets first, while H has more free slots. The buckets of a
+  // single item then fill the remaining ones.
+  pmh_multiply_slot_of<M, N> const slot_of{hashes};
+  for (const auto & bucket : buckets)
+    if (bucket.size())
+      G[bucket.hash] = place_pmh_bucket<M, N>(bucket, slot_of, prg, H, stats) | 1;
 
   return {step_one.seed, G, H, hash};
 }
 
+template <std::size_t M, class Item, std::size_t N, class Hash, class Key, class KeyEqual, class PRG>
+pmh_branchless_tables<M, Hash> constexpr make_pmh_branchless_tables(const carray<Item, N> &items, Hash const &hash,
+                                                                    KeyEqual const &equal, Key const &key, PRG prg) {
+  pmh_build_stats stats;
+  return make_pmh_branchless_tables<M>(items, hash, equal, key, prg, stats);
+}
+
+// Slot of an integer key in a single level table of M slots: the top log(M)
+// bits of key * multiplier.
+template <std::size_t M, typename Key>
+constexpr std::size_t multiply_shift_slot(Key const &key, std::uint64_t multiplier) {
+  constexpr auto shift = M > 1 ? 64 - log(M) : 63;
+  return static_cast<std::size_t>((static_cast<std::uint64_t>(key) * multiplier) >> shift);
+}
+
+// Hashers of integer keys Key whose tables try a single level first: elsa,
+// the default one. A hasher that only sometimes stands for elsa specializes
+// it, with a single_level(hash) that tells if `hash` does.
+template <class Key, class Hash> struct multiply_shift_hash : std::false_type {};
+template <class Key> struct multiply_shift_hash<Key, elsa<Key>> : std::true_type {
+  static constexpr bool single_level(elsa<Key> const &) { return true; }
+};
+
+// Perfect hash tables of integer keys that, when a multiplier sends every key
+// to its own slot, use a single level: the second table indexed by
+// multiply_shift_slot, one multiply, one shift and one load per lookup.
+// Otherwise multiplier_ is 0 and lookups go through the two levels.
+template <std::size_t M, class Key, class Hash = elsa<Key>>
+struct multiply_shift_tables : pmh_tables<M, Hash> {
+  std::uint64_t multiplier_;
+
+  constexpr multiply_shift_tables(pmh_tables<M, Hash> const &tables, std::uint64_t multiplier) noexcept
+    : pmh_tables<M, Hash>(tables)
+    , multiplier_(multiplier)
+  {}
+
+  template <typename KeyType>
+  constexpr std::size_t lookup(const KeyType & key) const {
+    return lookup(key, this->hash_function());
+  }
+
+  // The tables only depend on the keys when a multiplier is used, so
+  // `hasher` is then ignored.
+  template <typename KeyType, typename HasherType>
+  constexpr std::size_t lookup(const KeyType & key, const HasherType& hasher) const {
+    return multiplier_ ? this->second_table_[multiply_shift_slot<M, Key>(key, multiplier_)]
+                       : pmh_tables<M, Hash>::lookup(key, hasher);
+  }
+
+  template <typename KeyIt, typename HasherType>
+  void lookup_batch(KeyIt keys, std::size_t count, const HasherType& hasher, std::size_t *indices) const {
+    if (!multiplier_)
+      return pmh_tables<M, Hash>::lookup_batch(keys, count, hasher, indices);
+    for (std::size_t i = 0; i < count; ++i)
+      indices[i] = this->second_table_[multiply_shift_slot<M, Key>(keys[i], multiplier_)];
+  }
+};
+
+// Number of odd multipliers tried, after the powers of two, before falling
+// back to two levels. One fits keys with no structure with a probability of
+// about exp(-N * N / 2M): enough for up to 25 such keys in M = 64 slots.
+constexpr std::size_t multiply_shift_attempts = 256;
+
+template <std::size_t M, class Item, std::size_t N, class Key>
+constexpr bool multiplier_fits(const carray<Item, N> &items, Key const &key, std::uint64_t multiplier,
+                               carray<std::size_t, M> &stamps, std::size_t stamp) {
+  for (std::size_t i = 0; i < N; ++i) {
+    auto &slot = stamps[multiply_shift_slot<M>(key(items[i]), multiplier)];
+    if (slot == stamp)
+      return false;
+    slot = stamp;
+  }
+  return true;
+}
+
+// A multiplier that sends the keys of `items` to distinct slots, or 0. Powers
+// of two come first, they keep dense and strided keys in order, then odd
+// multipliers drawn from a fixed sequence, splitmix64.
+template <std::size_t M, class Item, std::size_t N, class Key>
+constexpr std::uint64_t find_multiplier(const carray<Item, N> &items, Key const &key) {
+  if (M < 2 || N == 0)
+    return 0;
+  carray<std::size_t, M> stamps(0);
+  std::size_t stamp = 0;
+  for (std::size_t bit = 0; bit < 64; ++bit) {
+    std::uint64_t const multiplier = std::uint64_t(1) << bit;
+    if (multiplier_fits(items, key, multiplier, stamps, ++stamp))
+      return multiplier;
+  }
+  for (std::uint64_t attempt = 1; attempt <= multiply_shift_attempts; ++attempt) {
+    std::uint64_t z = attempt * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    std::uint64_t const multiplier = (z ^ (z >> 31)) | 1;
+    if (multiplier_fits(items, key, multiplier, stamps, ++stamp))
+      return multiplier;
+  }
+  return 0;
+}
+
+template <std::size_t M, class T, class Item, std::size_t N, class Hash, class Key, class KeyEqual, class PRG>
+multiply_shift_tables<M, T, Hash> constexpr make_multiply_shift_tables(const carray<Item, N> &items,
+                                                                       Hash const &hash, KeyEqual const &equal,
+                                                                       Key const &key, PRG prg) {
+  auto const multiplier =
+      multiply_shift_hash<T, Hash>::single_level(hash) ? find_multiplier<M>(items, key) : std::uint64_t(0);
+  if (!multiplier)
+    return {make_pmh_tables<M>(items, hash, equal, key, prg), 0};
+
+  carray<std::size_t, M> H(N);
+  for (std::size_t i = 0; i < N; ++i)
+    H[multiply_shift_slot<M>(key(items[i]), multiplier)] = i;
+  return {{0, carray<seed_or_index, M>({false, N}), H, hash}, multiplier};
+}
+
+} // namespace bits
+
+// Hasher `Hash`, for unordered containers whose lookups should not branch:
+// their tables are laid out as bits::pmh_branchless_tables.
+template <class Hash> struct branchless_hash : Hash {
+  constexpr branchless_hash() = default;
+  constexpr branchless_hash(Hash const &hash) : Hash(hash) {}
+};
+
+namespace bits {
+
+// Tables of the unordered containers: integer keys hashed by the default
+// elsa, see multiply_shift_hash, try a single level first, branchless_hash
+// gets branchless tables.
+template <std::size_t M, class Key, class Hash>
+struct pmh_tables_select
+    : std::conditional<(std::is_integral<Key>::value || std::is_enum<Key>::value) &&
+                           multiply_shift_hash<Key, Hash>::value,
+                       multiply_shift_tables<M, Key, Hash>, pmh_tables<M, Hash>> {};
+template <std::size_t M, class Key, class Hash>
+struct pmh_tables_select<M, Key, branchless_hash<Hash>> {
+  using type = pmh_branchless_tables<M, branchless_hash<Hash>>;
+};
+
+template <std::size_t M, class Key, class Hash>
+using pmh_tables_for = typename pmh_tables_select<M, Key, Hash>::type;
+
+template <class Tables> struct tables_tag {};
+
+template <std::size_t M, class Item, std::size_t N, class Hash, class Key, class KeyEqual, class PRG>
+pmh_tables<M, Hash> constexpr make_tables(tables_tag<pmh_tables<M, Hash>>, const carray<Item, N> &items,
+                                          Hash const &hash, KeyEqual const &equal, Key const &key, PRG prg) {
+  return make_pmh_tables<M>(items, hash, equal, key, prg);
+}
+template <std::size_t M, class Item, std::size_t N, class Hash, class Key, class KeyEqual, class PRG>
+pmh_branchless_tables<M, Hash> constexpr make_tables(tables_tag<pmh_branchless_tables<M, Hash>>,
+                                                     const carray<Item, N> &items, Hash const &hash,
+                                                     KeyEqual const &equal, Key const &key, PRG prg) {
+  return make_pmh_branchless_tables<M>(items, hash, equal, key, prg);
+}
+template <std::size_t M, class Item, std::size_t N, class T, class Hash, class Key, class KeyEqual, class PRG>
+multiply_shift_tables<M, T, Hash> constexpr make_tables(tables_tag<multiply_shift_tables<M, T, Hash>>,
+                                                        const carray<Item, N> &items, Hash const &hash,
+                                                        KeyEqual const &equal, Key const &key, PRG prg) {
+  return make_multiply_shift_tables<M, T>(items, hash, equal, key, prg);
+}
+
 } // namespace bits
 
 } // namespace frozen
@@ -0,0 +1,98 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_BITS_STRING_COMPARE_H
+#define FROZEN_LETITGO_BITS_STRING_COMPARE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FROZEN_LETITGO_HAS_SSE2
+#endif
+
+namespace frozen {
+
+namespace bits {
+
+// Runtime versions of the character loops of basic_string, never used
+// during constant evaluation.
+
+// Length, in characters, from which these beat a character loop.
+constexpr std::size_t str_block_size = 16;
+
+template <class CharT>
+bool str_equal(CharT const *lhs, CharT const *rhs, std::size_t size) {
+  return std::memcmp(lhs, rhs, size * sizeof(CharT)) == 0;
+}
+
+// Once inlined, GCC may warn about the block loads for short constant
+// strings, on paths where the bound check already excludes them.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+
+// Index of the first character that differs in [lhs, lhs + size) and
+// [rhs, rhs + size), or `size` if there is none. Compares 16 bytes at once
+// when SSE2 is available, 8 otherwise, then finishes one character at a time.
+template <class CharT>
+std::size_t str_mismatch(CharT const *lhs, CharT const *rhs, std::size_t size) {
+  std::size_t i = 0;
+#ifdef FROZEN_LETITGO_HAS_SSE2
+  constexpr std::size_t per_block = 16 / sizeof(CharT);
+  for (; i + per_block <= size; i += per_block) {
+    __m128i const l = _mm_loadu_si128(reinterpret_cast<__m128i const *>(lhs + i));
+    __m128i const r = _mm_loadu_si128(reinterpret_cast<__m128i const *>(rhs + i));
+    unsigned const equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)));
+    if (equal != 0xFFFF) {
+      unsigned byte = 0;
+      while (equal & (1u << byte))
+        ++byte;
+      return i + byte / sizeof(CharT);
+    }
+  }
+#endif
+  constexpr std::size_t per_word = sizeof(std::uint64_t) / sizeof(CharT);
+  for (; i + per_word <= size; i += per_word) {
+    std::uint64_t l, r;
+    std::memcpy(&l, lhs + i, sizeof(l));
+    std::memcpy(&r, rhs + i, sizeof(r));
+    if (l != r)
+      break;
+  }
+  while (i < size && lhs[i] == rhs[i])
+    ++i;
+  return i;
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace bits
+
+} // namespace frozen
+
+#endif
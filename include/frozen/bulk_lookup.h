@@ -0,0 +1,152 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_BULK_LOOKUP_H
+#define FROZEN_LETITGO_BULK_LOOKUP_H
+
+#include "frozen/bits/defines.h"
+#include "frozen/bits/parallel.h"
+#include "frozen/bits/pmh.h"
+#include "frozen/unordered_map.h"
+#include "frozen/unordered_set.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace frozen {
+
+namespace bits {
+
+// Smallest number of keys handed to a thread at once, so that scheduling
+// stays negligible next to the lookups.
+constexpr std::size_t bulk_chunk_size = 1 << 14;
+
+template <class... Ts> struct make_void { using type = void; };
+
+template <class Table, class = void>
+struct has_mapped_type : std::false_type {};
+template <class Table>
+struct has_mapped_type<Table, typename make_void<typename Table::mapped_type>::type>
+    : std::true_type {};
+
+template <class Table, class = void>
+struct has_pmh_tables : std::false_type {};
+template <class Table>
+struct has_pmh_tables<Table, typename make_void<decltype(pmh_access::tables(std::declval<Table const &>()))>::type>
+    : std::true_type {};
+
+// Calls `found(i, it)` for each key in [keys, keys + count), with `it` the
+// result of `table.find(keys[i])`. Perfect hash containers look the keys up
+// pmh_batch_size at a time, and prefetch the matching items before comparing
+// them to the keys.
+template <class Table, class KeyIt, class Found>
+void bulk_find(Table const &table, KeyIt keys, std::size_t count, Found const &found, std::true_type) {
+  using key_of = typename std::conditional<has_mapped_type<Table>::value, GetKey, Get>::type;
+  auto const &tables = pmh_access::tables(table);
+  auto const items = table.begin();
+  std::size_t const size = table.size();
+  std::size_t indices[pmh_batch_size];
+
+  for (std::size_t i = 0; i < count; i += pmh_batch_size) {
+    std::size_t const batch = std::min(pmh_batch_size, count - i);
+    tables.lookup_batch(keys + i, batch, table.hash_function(), indices);
+    for (std::size_t j = 0; j < batch; ++j)
+      if (indices[j] < size)
+        FROZEN_LETITGO_PREFETCH(&items[indices[j]]);
+    for (std::size_t j = 0; j < batch; ++j) {
+      auto const &key = keys[i + j];
+      if (indices[j] < size && table.key_eq()(key_of{}(items[indices[j]]), key))
+        found(i + j, items + indices[j]);
+      else
+        found(i + j, table.end());
+    }
+  }
+}
+
+template <class Table, class KeyIt, class Found>
+void bulk_find(Table const &table, KeyIt keys, std::size_t count, Found const &found, std::false_type) {
+  for (std::size_t i = 0; i < count; ++i)
+    found(i, table.find(keys[i]));
+}
+
+// Splits [keys, keys + count) in chunks of at least bulk_chunk_size keys,
+// about four per thread, and runs bulk_find over each chunk.
+template <class Table, class KeyIt, class Found>
+void parallel_bulk_find(Table const &table, KeyIt keys, std::size_t count, unsigned threads, Found const &found) {
+  std::size_t const per_chunk = std::max(bulk_chunk_size, count / (4 * std::size_t(threads ? threads : 1)) + 1);
+  std::size_t const chunks = (count + per_chunk - 1) / per_chunk;
+  parallel_for(chunks, threads, [&](std::size_t chunk) {
+    std::size_t const first = chunk * per_chunk;
+    std::size_t const last = std::min(count, first + per_chunk);
+    bulk_find(table, keys + first, last - first,
+              [&found, first](std::size_t i, typename Table::const_iterator it) { found(first + i, it); },
+              has_pmh_tables<Table>{});
+  });
+}
+
+template <class FoundIt>
+void check_bulk_output() {
+  // Each thread writes its own range of `out_found`, which must not share
+  // memory with its neighbours, as the bits of std::vector<bool> do.
+  static_assert(std::is_lvalue_reference<decltype(*std::declval<FoundIt>())>::value,
+                "out_found must point to addressable elements");
+}
+
+} // namespace bits
+
+// Looks up each key in [first, last) in `table`, a map, unordered_map or
+// dynamic_unordered_map, and stores in `out_values` its value, or a value
+// initialized one if the key is absent, and in `out_found` whether it is
+// present. Keys and outputs are random access, the outputs are written in
+// place and hold at least `last - first` elements. The keys are split across
+// at most `threads` threads, the calling one included.
+template <class Table, class KeyIt, class ValueIt, class FoundIt>
+void bulk_lookup(Table const &table, KeyIt first, KeyIt last, ValueIt out_values, FoundIt out_found,
+                 unsigned threads = bits::default_thread_count()) {
+  static_assert(bits::has_mapped_type<Table>::value, "bulk_lookup requires a map, use bulk_contains for sets");
+  bits::check_bulk_output<FoundIt>();
+  bits::parallel_bulk_find(table, first, static_cast<std::size_t>(last - first), threads,
+                           [&](std::size_t i, typename Table::const_iterator it) {
+                             bool const found = it != table.end();
+                             out_values[i] = found ? it->second : typename Table::mapped_type{};
+                             out_found[i] = found;
+                           });
+}
+
+// Same as bulk_lookup, for any frozen container, sets included: only stores
+// whether each key is present.
+template <class Table, class KeyIt, class FoundIt>
+void bulk_contains(Table const &table, KeyIt first, KeyIt last, FoundIt out_found,
+                   unsigned threads = bits::default_thread_count()) {
+  bits::check_bulk_output<FoundIt>();
+  bits::parallel_bulk_find(table, first, static_cast<std::size_t>(last - first), threads,
+                           [&](std::size_t i, typename Table::const_iterator it) {
+                             out_found[i] = it != table.end();
+                           });
+}
+
+} // namespace frozen
+
+#endif
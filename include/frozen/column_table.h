@@ -0,0 +1,204 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_COLUMN_TABLE_H
+#define FROZEN_LETITGO_COLUMN_TABLE_H
+
+#include "frozen/bits/basic_types.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/set.h"
+#include "frozen/unordered_set.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace frozen {
+
+namespace bits {
+
+// Number of keys of the key index of a column table.
+template <class Index> struct index_size;
+template <class Key, std::size_t N, class Compare>
+struct index_size<set<Key, N, Compare>> : std::integral_constant<std::size_t, N> {};
+template <class Key, std::size_t N, class Hash, class KeyEqual>
+struct index_size<unordered_set<Key, N, Hash, KeyEqual>> : std::integral_constant<std::size_t, N> {};
+
+// Field I of row order[i] of `rows`.
+template <std::size_t I, class Rows, class Order>
+struct row_field {
+  Rows const &rows;
+  Order const &order;
+
+  constexpr auto const &operator()(std::size_t i) const { return std::get<I>(rows[order[i]]); }
+};
+
+struct identity_order {
+  constexpr std::size_t operator[](std::size_t i) const { return i; }
+};
+
+// carray of make(0), ..., make(N - 1). Filled in a loop when T allows it, as
+// expanding a pack of N values gets slow to compile for large tables.
+template <class T, std::size_t N, class Make>
+constexpr carray<T, N> generate_carray(Make const &make, std::true_type) {
+  carray<T, N> result{};
+  for (std::size_t i = 0; i < N; ++i)
+    result[i] = make(i);
+  return result;
+}
+template <class T, std::size_t N, class Make, std::size_t... Is>
+constexpr carray<T, N> generate_carray(Make const &make, std::index_sequence<Is...>) {
+  return carray<T, N>{make(Is)...};
+}
+template <class T, std::size_t N, class Make>
+constexpr carray<T, N> generate_carray(Make const &make, std::false_type) {
+  return generate_carray<T, N>(make, std::make_index_sequence<N>{});
+}
+template <class T, std::size_t N, class Make>
+constexpr carray<T, N> generate_carray(Make const &make) {
+  return generate_carray<T, N>(
+      make, std::integral_constant<bool, std::is_default_constructible<T>::value &&
+                                             std::is_copy_assignable<T>::value>{});
+}
+
+} // namespace bits
+
+// Several values per key, stored column by column rather than as one struct
+// per key: column I holds the I-th value of every key, contiguous, at the
+// index_of(key) of the key index, a frozen set or unordered_set. A lookup
+// gets the index once, then only reads the columns it needs.
+template <class Index, class... Columns>
+class basic_column_table {
+  static constexpr std::size_t N = bits::index_size<Index>::value;
+
+public:
+  /* typedefs */
+  using index_type = Index;
+  using key_type = typename Index::key_type;
+  using row_type = std::tuple<key_type, Columns...>;
+  using size_type = std::size_t;
+  template <std::size_t I>
+  using column_type = typename std::tuple_element<I, std::tuple<Columns...>>::type;
+
+private:
+  using container_type = bits::carray<row_type, N>;
+  using columns_type = std::tuple<bits::carray<Columns, N>...>;
+
+  Index index_;
+  columns_type columns_;
+
+public:
+  /* constructors */
+  explicit constexpr basic_column_table(container_type const &rows)
+      : index_{bits::generate_carray<key_type, N>(
+            bits::row_field<0, container_type, bits::identity_order>{rows, bits::identity_order{}})}
+      , columns_{make_columns(rows, row_order(rows, index_), std::index_sequence_for<Columns...>{})} {}
+  constexpr basic_column_table(std::initializer_list<row_type> rows)
+      : basic_column_table{container_type{rows}} {}
+
+  /* capacity */
+  constexpr bool empty() const { return !N; }
+  constexpr size_type size() const { return N; }
+  static constexpr std::size_t column_count() { return sizeof...(Columns); }
+
+  /* lookup */
+  template <class KeyType>
+  constexpr std::size_t count(KeyType const &key) const {
+    return index_.count(key);
+  }
+
+  template <class KeyType>
+  constexpr bool contains(KeyType const &key) const {
+    return index_.contains(key);
+  }
+
+  // Index of the values of the given key in each column, size() if there is
+  // none.
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &key) const {
+    return index_.index_of(key);
+  }
+
+  template <std::size_t I, class KeyType>
+  constexpr column_type<I> const &at(KeyType const &key) const {
+    return column<I>()[checked_index_of(key)];
+  }
+  template <std::size_t I, class KeyType>
+  constexpr column_type<I> &at(KeyType const &key) {
+    return column<I>()[checked_index_of(key)];
+  }
+
+  /* columns */
+  template <std::size_t I>
+  constexpr bits::carray<column_type<I>, N> const &column() const {
+    return std::get<I>(columns_);
+  }
+  template <std::size_t I>
+  constexpr bits::carray<column_type<I>, N> &column() {
+    return std::get<I>(columns_);
+  }
+
+  /* observers */
+  constexpr Index const &index() const { return index_; }
+
+private:
+  template <class KeyType>
+  constexpr std::size_t checked_index_of(KeyType const &key) const {
+    auto const index = index_of(key);
+    if (index == N)
+      FROZEN_THROW_OR_ABORT(std::out_of_range("unknown key"));
+    return index;
+  }
+
+  // order[i] is the row holding the key of index i.
+  static constexpr bits::carray<std::size_t, N> row_order(container_type const &rows, Index const &index) {
+    bits::carray<std::size_t, N> order{};
+    for (std::size_t r = 0; r < N; ++r)
+      order[index.index_of(std::get<0>(rows[r]))] = r;
+    return order;
+  }
+
+  template <std::size_t... Cs>
+  static constexpr columns_type make_columns(container_type const &rows, bits::carray<std::size_t, N> const &order,
+                                             std::index_sequence<Cs...>) {
+    using order_type = bits::carray<std::size_t, N>;
+    return columns_type{bits::generate_carray<column_type<Cs>, N>(
+        bits::row_field<Cs + 1, container_type, order_type>{rows, order})...};
+  }
+};
+
+// Column table with its keys in a frozen::unordered_set: the values of a key
+// are at the index of its row.
+template <class Key, std::size_t N, class... Columns>
+using column_table = basic_column_table<unordered_set<Key, N>, Columns...>;
+
+template <typename Key, typename... Columns, std::size_t N>
+constexpr auto make_column_table(std::tuple<Key, Columns...> const (&rows)[N]) {
+  return column_table<Key, N, Columns...>{rows};
+}
+
+} // namespace frozen
+
+#endif
@@ -0,0 +1,189 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_COMPACT_UNORDERED_MAP_H
+#define FROZEN_LETITGO_COMPACT_UNORDERED_MAP_H
+
+#include "frozen/bits/compact_pmh.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/random.h"
+#include "frozen/unordered_map.h"
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+// Same as frozen::dynamic_unordered_map, with a perfect hash function of
+// about 3 bits per key, see compact_unordered_set. The items are stored in
+// the order of the hashes of their keys.
+template <class Key, class Value, typename Hash = anna<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class compact_unordered_map : private KeyEqual {
+  using container_type = std::vector<std::pair<const Key, Value>>;
+  using tables_type = bits::compact_pmh_tables<Hash>;
+
+  container_type items_;
+  tables_type tables_;
+
+  friend struct bits::pmh_access;
+
+public:
+  /* typedefs */
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = typename container_type::value_type;
+  using size_type = typename container_type::size_type;
+  using difference_type = typename container_type::difference_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = typename container_type::reference;
+  using const_reference = typename container_type::const_reference;
+  using pointer = typename container_type::pointer;
+  using const_pointer = typename container_type::const_pointer;
+  using iterator = typename container_type::iterator;
+  using const_iterator = typename container_type::const_iterator;
+
+public:
+  /* constructors */
+  template <class InputIt>
+  compact_unordered_map(InputIt first, InputIt last,
+                        Hash const &hash, KeyEqual const &equal)
+      : compact_unordered_map{bits::make_compact_pmh(container_type(first, last), hash, equal,
+                                                     bits::GetKey{}, default_prg_t{}),
+                              equal} {}
+  template <class InputIt>
+  compact_unordered_map(InputIt first, InputIt last)
+      : compact_unordered_map{first, last, Hash{}, KeyEqual{}} {}
+
+  compact_unordered_map(std::initializer_list<value_type> items,
+                        Hash const & hash, KeyEqual const & equal)
+      : compact_unordered_map{items.begin(), items.end(), hash, equal} {}
+
+  compact_unordered_map(std::initializer_list<value_type> items)
+      : compact_unordered_map{items, Hash{}, KeyEqual{}} {}
+
+  /* iterators */
+  iterator begin() { return items_.begin(); }
+  iterator end() { return items_.end(); }
+  const_iterator begin() const { return items_.begin(); }
+  const_iterator end() const { return items_.end(); }
+  const_iterator cbegin() const { return items_.begin(); }
+  const_iterator cend() const { return items_.end(); }
+
+  /* capacity */
+  bool empty() const { return items_.empty(); }
+  size_type size() const { return items_.size(); }
+  size_type max_size() const { return items_.size(); }
+
+  /* lookup */
+  template <class KeyType>
+  std::size_t count(KeyType const &key) const {
+    return find(key) != end();
+  }
+
+  template <class KeyType>
+  Value const &at(KeyType const &key) const {
+    return at_impl(*this, key);
+  }
+  template <class KeyType>
+  Value &at(KeyType const &key) {
+    return at_impl(*this, key);
+  }
+
+  template <class KeyType>
+  const_iterator find(KeyType const &key) const {
+    return find_impl(*this, key);
+  }
+  template <class KeyType>
+  iterator find(KeyType const &key) {
+    return find_impl(*this, key);
+  }
+
+  template <class KeyType>
+  bool contains(KeyType const &key) const {
+    return this->find(key) != this->end();
+  }
+
+  // Index of the item with the given key, size() if there is none.
+  template <class KeyType>
+  std::size_t index_of(KeyType const &key) const {
+    return static_cast<std::size_t>(find(key) - begin());
+  }
+
+  template <class KeyType>
+  std::pair<const_iterator, const_iterator> equal_range(KeyType const &key) const {
+    return equal_range_impl(*this, key);
+  }
+  template <class KeyType>
+  std::pair<iterator, iterator> equal_range(KeyType const &key) {
+    return equal_range_impl(*this, key);
+  }
+
+  /* bucket interface */
+  std::size_t bucket_count() const { return tables_.bucket_count(); }
+  std::size_t max_bucket_count() const { return tables_.bucket_count(); }
+
+  /* observers*/
+  const hasher& hash_function() const { return tables_.hash_function(); }
+  const key_equal& key_eq() const { return static_cast<KeyEqual const&>(*this); }
+
+private:
+  compact_unordered_map(bits::compact_pmh_build<value_type, Hash> &&build, KeyEqual const &equal)
+      : KeyEqual{equal}, items_(std::move(build.items)), tables_(std::move(build.tables)) {}
+
+  template <class This, class KeyType>
+  static inline auto& at_impl(This&& self, KeyType const &key) {
+    auto it = self.find(key);
+    if (it != self.end())
+      return it->second;
+    else
+      FROZEN_THROW_OR_ABORT(std::out_of_range("unknown key"));
+  }
+
+  template <class This, class KeyType>
+  static inline auto find_impl(This&& self, KeyType const &key) {
+    auto const pos = self.tables_.lookup(key, self.hash_function());
+    auto it = self.items_.begin() + pos;
+    if (it != self.items_.end() && self.key_eq()(it->first, key))
+      return it;
+    else
+      return self.items_.end();
+  }
+
+  template <class This, class KeyType>
+  static inline auto equal_range_impl(This&& self, KeyType const &key) {
+    auto const it = self.find(key);
+    if (it != self.end())
+      return std::make_pair(it, it + 1);
+    else
+      return std::make_pair(self.end(), self.end());
+  }
+};
+
+} // namespace frozen
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_COMPACT_UNORDERED_SET_H
+#define FROZEN_LETITGO_COMPACT_UNORDERED_SET_H
+
+#include "frozen/bits/compact_pmh.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/random.h"
+#include "frozen/unordered_set.h"
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+// Same as frozen::dynamic_unordered_set, with a perfect hash function of
+// about 3 bits per key, for large key sets whose dynamic_unordered_set tables
+// would not fit in the caches, at the cost of a few more operations per
+// lookup, see bits::compact_pmh_tables. The keys are stored in the order of
+// their hashes, not in the order they are given in. Built at runtime only:
+// large key sets exceed the constant evaluation limits of the compilers, and
+// the coded tables have no size known before they are built.
+template <class Key, typename Hash = elsa<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class compact_unordered_set : private KeyEqual {
+  using container_type = std::vector<Key>;
+  using tables_type = bits::compact_pmh_tables<Hash>;
+
+  container_type keys_;
+  tables_type tables_;
+
+  friend struct bits::pmh_access;
+
+public:
+  /* typedefs */
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = typename container_type::size_type;
+  using difference_type = typename container_type::difference_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using const_reference = typename container_type::const_reference;
+  using reference = const_reference;
+  using const_pointer = typename container_type::const_pointer;
+  using pointer = const_pointer;
+  using const_iterator = typename container_type::const_iterator;
+  using iterator = const_iterator;
+
+public:
+  /* constructors */
+  template <class InputIt>
+  compact_unordered_set(InputIt first, InputIt last, Hash const &hash,
+                        KeyEqual const &equal)
+      : compact_unordered_set{bits::make_compact_pmh(container_type(first, last), hash, equal,
+                                                     bits::Get{}, default_prg_t{}),
+                              equal} {}
+  template <class InputIt>
+  compact_unordered_set(InputIt first, InputIt last)
+      : compact_unordered_set{first, last, Hash{}, KeyEqual{}} {}
+
+  compact_unordered_set(std::initializer_list<Key> keys, Hash const & hash, KeyEqual const & equal)
+      : compact_unordered_set{keys.begin(), keys.end(), hash, equal} {}
+
+  compact_unordered_set(std::initializer_list<Key> keys)
+      : compact_unordered_set{keys, Hash{}, KeyEqual{}} {}
+
+  /* iterators */
+  const_iterator begin() const { return keys_.begin(); }
+  const_iterator end() const { return keys_.end(); }
+  const_iterator cbegin() const { return keys_.begin(); }
+  const_iterator cend() const { return keys_.end(); }
+
+  /* capacity */
+  bool empty() const { return keys_.empty(); }
+  size_type size() const { return keys_.size(); }
+  size_type max_size() const { return keys_.size(); }
+
+  /* lookup */
+  template <class KeyType>
+  std::size_t count(KeyType const &key) const {
+    return find(key) != end();
+  }
+
+  template <class KeyType>
+  const_iterator find(KeyType const &key) const {
+    auto const pos = tables_.lookup(key, hash_function());
+    auto it = keys_.begin() + pos;
+    if (it != keys_.end() && key_eq()(*it, key))
+      return it;
+    else
+      return keys_.end();
+  }
+
+  template <class KeyType>
+  bool contains(KeyType const &key) const {
+    return this->find(key) != keys_.end();
+  }
+
+  // Index of the given key, size() if there is none.
+  template <class KeyType>
+  std::size_t index_of(KeyType const &key) const {
+    return static_cast<std::size_t>(find(key) - begin());
+  }
+
+  template <class KeyType>
+  std::pair<const_iterator, const_iterator> equal_range(KeyType const &key) const {
+    auto const it = find(key);
+    if (it != end())
+      return {it, it + 1};
+    else
+      return {keys_.end(), keys_.end()};
+  }
+
+  /* bucket interface */
+  std::size_t bucket_count() const { return tables_.bucket_count(); }
+  std::size_t max_bucket_count() const { return tables_.bucket_count(); }
+
+  /* observers*/
+  const hasher& hash_function() const { return tables_.hash_function(); }
+  const key_equal& key_eq() const { return static_cast<KeyEqual const&>(*this); }
+
+private:
+  compact_unordered_set(bits::compact_pmh_build<Key, Hash> &&build, KeyEqual const &equal)
+      : KeyEqual{equal}, keys_(std::move(build.items)), tables_(std::move(build.tables)) {}
+};
+
+} // namespace frozen
+
+#endif
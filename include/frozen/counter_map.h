@@ -0,0 +1,187 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_COUNTER_MAP_H
+#define FROZEN_LETITGO_COUNTER_MAP_H
+
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/unordered_set.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+
+namespace frozen {
+
+namespace bits {
+
+constexpr std::size_t cache_line_size = 64;
+
+// Index of the calling thread, handed out in order of first use.
+inline std::size_t thread_index() {
+  static std::atomic<std::size_t> next{0};
+  thread_local std::size_t const index = next.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+// Counters of a counter_map, split in `Shards` copies. A thread only
+// increments the copy it is assigned to, so that threads incrementing the
+// same key do not contend, and reads sum all copies.
+template <class Counter, std::size_t N, std::size_t Shards>
+class counter_storage {
+  struct alignas(cache_line_size) shard {
+    std::atomic<Counter> values[N ? N : 1];
+  };
+  shard shards_[Shards];
+
+public:
+  constexpr counter_storage() : shards_{} {}
+
+  void add(std::size_t index, Counter delta) {
+    shards_[thread_index() % Shards].values[index].fetch_add(delta, std::memory_order_relaxed);
+  }
+  Counter load(std::size_t index) const {
+    Counter total{};
+    for (auto const &s : shards_)
+      total += s.values[index].load(std::memory_order_relaxed);
+    return total;
+  }
+  void reset(std::size_t index) {
+    for (auto &s : shards_)
+      s.values[index].store(Counter{}, std::memory_order_relaxed);
+  }
+};
+
+// Single copy: each counter is alone on its cache line instead, so that
+// threads incrementing different keys do not contend.
+template <class Counter, std::size_t N>
+class counter_storage<Counter, N, 1> {
+  struct alignas(cache_line_size) padded {
+    std::atomic<Counter> value;
+  };
+  padded values_[N ? N : 1];
+
+public:
+  constexpr counter_storage() : values_{} {}
+
+  void add(std::size_t index, Counter delta) {
+    values_[index].value.fetch_add(delta, std::memory_order_relaxed);
+  }
+  Counter load(std::size_t index) const {
+    return values_[index].value.load(std::memory_order_relaxed);
+  }
+  void reset(std::size_t index) {
+    values_[index].value.store(Counter{}, std::memory_order_relaxed);
+  }
+};
+
+} // namespace bits
+
+// Atomic counters for a fixed set of keys, e.g. per endpoint statistics.
+// Unlike the values of a frozen::unordered_map, counters are not stored next
+// to the keys: by default each one gets its own cache line, and with
+// `Shards` > 1 every thread increments its own copy of the counters, merged
+// on read. Increments are relaxed atomic additions.
+template <class Key, class Counter, std::size_t N, std::size_t Shards = 1,
+          typename Hash = elsa<Key>, class KeyEqual = std::equal_to<Key>>
+class counter_map {
+  static_assert(Shards > 0, "at least one copy of the counters is needed");
+
+  using keys_type = unordered_set<Key, N, Hash, KeyEqual>;
+
+  keys_type keys_;
+  bits::counter_storage<Counter, N, Shards> counters_;
+
+public:
+  /* typedefs */
+  using key_type = Key;
+  using counter_type = Counter;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+public:
+  /* constructors */
+  constexpr counter_map(std::initializer_list<Key> keys)
+      : keys_{keys}, counters_{} {}
+  constexpr counter_map(std::initializer_list<Key> keys, Hash const &hash, KeyEqual const &equal)
+      : keys_{keys, hash, equal}, counters_{} {}
+
+  counter_map(counter_map const &) = delete;
+  counter_map &operator=(counter_map const &) = delete;
+
+  /* capacity */
+  constexpr bool empty() const { return !N; }
+  constexpr size_type size() const { return N; }
+
+  /* keys */
+  constexpr keys_type const &keys() const { return keys_; }
+
+  template <class KeyType>
+  constexpr std::size_t count(KeyType const &key) const {
+    return keys_.count(key);
+  }
+
+  // Index of the counter of the given key, size() if there is none.
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &key) const {
+    return keys_.index_of(key);
+  }
+
+  /* counters */
+
+  // Adds `delta` to the counter of `key`. Returns false if `key` is unknown.
+  template <class KeyType>
+  bool add(KeyType const &key, Counter delta = Counter{1}) {
+    auto const index = keys_.index_of(key);
+    if (index == N)
+      return false;
+    counters_.add(index, delta);
+    return true;
+  }
+
+  template <class KeyType>
+  Counter load(KeyType const &key) const {
+    auto const index = keys_.index_of(key);
+    if (index == N)
+      FROZEN_THROW_OR_ABORT(std::out_of_range("unknown key"));
+    return counters_.load(index);
+  }
+
+  // Calls `f(key, counter)` for each key, in the order of keys().
+  template <class F>
+  void for_each(F &&f) const {
+    for (std::size_t i = 0; i < N; ++i)
+      f(keys_.begin()[i], counters_.load(i));
+  }
+
+  void reset() {
+    for (std::size_t i = 0; i < N; ++i)
+      counters_.reset(i);
+  }
+};
+
+} // namespace frozen
+
+#endif
@@ -0,0 +1,287 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_DYNAMIC_UNORDERED_MAP_H
+#define FROZEN_LETITGO_DYNAMIC_UNORDERED_MAP_H
+
+#include "frozen/bits/dynamic_pmh.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/random.h"
+#include "frozen/unordered_map.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+// Same as frozen::unordered_map, for keys only known at runtime: the perfect
+// hash function is built once, when the map is constructed, and the number of
+// items is set at that time. Items and tables are each stored in one
+// contiguous block, never reallocated.
+template <class Key, class Value, typename Hash = anna<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class dynamic_unordered_map : private KeyEqual {
+  using container_type = std::vector<std::pair<const Key, Value>>;
+  using tables_type = bits::dynamic_pmh_tables<Hash>;
+
+  container_type items_;
+  tables_type tables_;
+
+  friend struct bits::pmh_access;
+
+public:
+  /* typedefs */
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = typename container_type::value_type;
+  using size_type = typename container_type::size_type;
+  using difference_type = typename container_type::difference_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = typename container_type::reference;
+  using const_reference = typename container_type::const_reference;
+  using pointer = typename container_type::pointer;
+  using const_pointer = typename container_type::const_pointer;
+  using iterator = typename container_type::iterator;
+  using const_iterator = typename container_type::const_iterator;
+
+public:
+  /* constructors */
+  template <class InputIt>
+  dynamic_unordered_map(InputIt first, InputIt last,
+                        Hash const &hash, KeyEqual const &equal)
+      : KeyEqual{equal}
+      , items_(first, last)
+      , tables_{bits::make_dynamic_pmh_tables(
+            items_, bits::pmh_storage_size(items_.size()), hash, equal,
+            bits::GetKey{}, default_prg_t{})} {}
+  template <class InputIt>
+  dynamic_unordered_map(InputIt first, InputIt last)
+      : dynamic_unordered_map{first, last, Hash{}, KeyEqual{}} {}
+
+  // Builds the perfect hash function on several threads, see
+  // bits::make_sharded_pmh_tables.
+  template <class InputIt>
+  dynamic_unordered_map(InputIt first, InputIt last, parallel_build build,
+                        Hash const &hash, KeyEqual const &equal)
+      : KeyEqual{equal}
+      , items_(first, last)
+      , tables_{bits::make_sharded_pmh_tables(
+            items_, hash, equal, bits::GetKey{}, default_prg_t{},
+            build.threads)} {}
+  template <class InputIt>
+  dynamic_unordered_map(InputIt first, InputIt last, parallel_build build)
+      : dynamic_unordered_map{first, last, build, Hash{}, KeyEqual{}} {}
+
+  dynamic_unordered_map(std::initializer_list<value_type> items,
+                        Hash const & hash, KeyEqual const & equal)
+      : dynamic_unordered_map{items.begin(), items.end(), hash, equal} {}
+
+  dynamic_unordered_map(std::initializer_list<value_type> items)
+      : dynamic_unordered_map{items, Hash{}, KeyEqual{}} {}
+
+  /* iterators */
+  iterator begin() { return items_.begin(); }
+  iterator end() { return items_.end(); }
+  const_iterator begin() const { return items_.begin(); }
+  const_iterator end() const { return items_.end(); }
+  const_iterator cbegin() const { return items_.begin(); }
+  const_iterator cend() const { return items_.end(); }
+
+  /* capacity */
+  bool empty() const { return items_.empty(); }
+  size_type size() const { return items_.size(); }
+  size_type max_size() const { return items_.size(); }
+
+  /* lookup */
+  template <class KeyType>
+  std::size_t count(KeyType const &key) const {
+    return find(key) != end();
+  }
+
+  template <class KeyType>
+  Value const &at(KeyType const &key) const {
+    return at_impl(*this, key);
+  }
+  template <class KeyType>
+  Value &at(KeyType const &key) {
+    return at_impl(*this, key);
+  }
+
+  template <class KeyType>
+  const_iterator find(KeyType const &key) const {
+    return find_impl(*this, key, hash_function(), key_eq());
+  }
+  template <class KeyType>
+  iterator find(KeyType const &key) {
+    return find_impl(*this, key, hash_function(), key_eq());
+  }
+
+  // Same as find, for a key whose base hash was already computed, e.g. by an
+  // incremental_elsa state_type: the key is not hashed again.
+  template <class KeyType>
+  const_iterator find_hashed(KeyType const &key, std::uint64_t hash) const {
+    return find_impl(*this, key, bits::prehashed<Hash>{hash_function(), hash}, key_eq());
+  }
+  template <class KeyType>
+  iterator find_hashed(KeyType const &key, std::uint64_t hash) {
+    return find_impl(*this, key, bits::prehashed<Hash>{hash_function(), hash}, key_eq());
+  }
+
+  template <class KeyType>
+  bool contains(KeyType const &key) const {
+    return this->find(key) != this->end();
+  }
+
+  // Index of the item with the given key, size() if there is none.
+  template <class KeyType>
+  std::size_t index_of(KeyType const &key) const {
+    return static_cast<std::size_t>(find(key) - begin());
+  }
+
+  template <class KeyType>
+  std::pair<const_iterator, const_iterator> equal_range(KeyType const &key) const {
+    return equal_range_impl(*this, key);
+  }
+  template <class KeyType>
+  std::pair<iterator, iterator> equal_range(KeyType const &key) {
+    return equal_range_impl(*this, key);
+  }
+
+  /* rebuild */
+
+  // Copy of this map, with the keys in [erase_first, erase_last) erased then
+  // the items in [first, last) inserted or assigned. The perfect hash
+  // function is patched rather than rebuilt: only the buckets that receive a
+  // new key are seeded again, unless they no longer fit.
+  template <class InputIt, class KeyIt>
+  dynamic_unordered_map rebuild(InputIt first, InputIt last,
+                                KeyIt erase_first, KeyIt erase_last) const {
+    std::vector<std::size_t> removed;
+    for (; erase_first != erase_last; ++erase_first) {
+      auto const where = find(*erase_first);
+      if (where != end())
+        removed.push_back(where - begin());
+    }
+    std::sort(removed.begin(), removed.end());
+    removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+
+    std::vector<std::pair<std::size_t, Value>> assigned;
+    std::vector<value_type> inserted;
+    for (; first != last; ++first) {
+      auto const where = find(first->first);
+      if (where != end())
+        assigned.emplace_back(where - begin(), first->second);
+      else
+        inserted.emplace_back(first->first, first->second);
+    }
+    // New keys given several times are added once, with their last value.
+    std::vector<value_type> added;
+    for (auto const i : bits::pmh_last_of_each_key(inserted, hash_function(), key_eq(), bits::GetKey{}))
+      added.push_back(inserted[i]);
+    // Erased then assigned keys are kept.
+    for (auto const &item : assigned) {
+      auto const where = std::lower_bound(removed.begin(), removed.end(), item.first);
+      if (where != removed.end() && *where == item.first)
+        removed.erase(where);
+    }
+
+    container_type items;
+    items.reserve(items_.size() - removed.size() + added.size());
+    auto const moves = bits::pmh_swap_fill(items_.size(), removed);
+    for (std::size_t i = 0, next = 0, kept = items_.size() - removed.size(); i < kept; ++i) {
+      if (next < moves.size() && moves[next].second == i)
+        items.push_back(items_[moves[next++].first]);
+      else
+        items.push_back(items_[i]);
+    }
+    std::size_t const kept = items.size();
+    for (auto const &item : assigned) {
+      auto const moved = std::find_if(moves.begin(), moves.end(), [&](std::pair<std::size_t, std::size_t> const &move) {
+        return move.first == item.first;
+      });
+      items[moved == moves.end() ? item.first : moved->second].second = item.second;
+    }
+    for (auto const &item : added)
+      items.push_back(item);
+
+    auto tables = bits::rebuild_pmh_tables(tables_, items_, removed, items, kept,
+                                           hash_function(), key_eq(),
+                                           bits::GetKey{}, default_prg_t{});
+    return {std::move(items), std::move(tables), key_eq()};
+  }
+  template <class InputIt>
+  dynamic_unordered_map rebuild(InputIt first, InputIt last) const {
+    key_type const *none = nullptr;
+    return rebuild(first, last, none, none);
+  }
+
+  /* bucket interface */
+  std::size_t bucket_count() const { return tables_.size(); }
+  std::size_t max_bucket_count() const { return tables_.size(); }
+
+  /* observers*/
+  const hasher& hash_function() const { return tables_.hash_function(); }
+  const key_equal& key_eq() const { return static_cast<KeyEqual const&>(*this); }
+
+private:
+  dynamic_unordered_map(container_type &&items, tables_type &&tables, KeyEqual const &equal)
+      : KeyEqual{equal}, items_(std::move(items)), tables_(std::move(tables)) {}
+
+  template <class This, class KeyType>
+  static inline auto& at_impl(This&& self, KeyType const &key) {
+    auto it = self.find(key);
+    if (it != self.end())
+      return it->second;
+    else
+      FROZEN_THROW_OR_ABORT(std::out_of_range("unknown key"));
+  }
+
+  template <class This, class KeyType, class Hasher, class Equal>
+  static inline auto find_impl(This&& self, KeyType const &key, Hasher const &hash, Equal const &equal) {
+    auto const pos = self.tables_.lookup(key, hash);
+    auto it = self.items_.begin() + pos;
+    if (it != self.items_.end() && equal(it->first, key))
+      return it;
+    else
+      return self.items_.end();
+  }
+
+  template <class This, class KeyType>
+  static inline auto equal_range_impl(This&& self, KeyType const &key) {
+    auto const it = self.find(key);
+    if (it != self.end())
+      return std::make_pair(it, it + 1);
+    else
+      return std::make_pair(self.end(), self.end());
+  }
+};
+
+} // namespace frozen
+
+#endif
@@ -0,0 +1,235 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_DYNAMIC_UNORDERED_SET_H
+#define FROZEN_LETITGO_DYNAMIC_UNORDERED_SET_H
+
+#include "frozen/bits/dynamic_pmh.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/random.h"
+#include "frozen/unordered_set.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+// Same as frozen::unordered_set, for keys only known at runtime: the perfect
+// hash function is built once, when the set is constructed, and the number of
+// keys is set at that time.
+template <class Key, typename Hash = elsa<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class dynamic_unordered_set : private KeyEqual {
+  using container_type = std::vector<Key>;
+  using tables_type = bits::dynamic_pmh_tables<Hash>;
+
+  container_type keys_;
+  tables_type tables_;
+
+  friend struct bits::pmh_access;
+
+public:
+  /* typedefs */
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = typename container_type::size_type;
+  using difference_type = typename container_type::difference_type;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using const_reference = typename container_type::const_reference;
+  using reference = const_reference;
+  using const_pointer = typename container_type::const_pointer;
+  using pointer = const_pointer;
+  using const_iterator = typename container_type::const_iterator;
+  using iterator = const_iterator;
+
+public:
+  /* constructors */
+  template <class InputIt>
+  dynamic_unordered_set(InputIt first, InputIt last, Hash const &hash,
+                        KeyEqual const &equal)
+      : KeyEqual{equal}
+      , keys_(first, last)
+      , tables_{bits::make_dynamic_pmh_tables(
+            keys_, bits::pmh_storage_size(keys_.size()), hash, equal,
+            bits::Get{}, default_prg_t{})} {}
+  template <class InputIt>
+  dynamic_unordered_set(InputIt first, InputIt last)
+      : dynamic_unordered_set{first, last, Hash{}, KeyEqual{}} {}
+
+  // Builds the perfect hash function on several threads, see
+  // bits::make_sharded_pmh_tables.
+  template <class InputIt>
+  dynamic_unordered_set(InputIt first, InputIt last, parallel_build build,
+                        Hash const &hash, KeyEqual const &equal)
+      : KeyEqual{equal}
+      , keys_(first, last)
+      , tables_{bits::make_sharded_pmh_tables(
+            keys_, hash, equal, bits::Get{}, default_prg_t{},
+            build.threads)} {}
+  template <class InputIt>
+  dynamic_unordered_set(InputIt first, InputIt last, parallel_build build)
+      : dynamic_unordered_set{first, last, build, Hash{}, KeyEqual{}} {}
+
+  dynamic_unordered_set(std::initializer_list<Key> keys, Hash const & hash, KeyEqual const & equal)
+      : dynamic_unordered_set{keys.begin(), keys.end(), hash, equal} {}
+
+  dynamic_unordered_set(std::initializer_list<Key> keys)
+      : dynamic_unordered_set{keys, Hash{}, KeyEqual{}} {}
+
+  /* iterators */
+  const_iterator begin() const { return keys_.begin(); }
+  const_iterator end() const { return keys_.end(); }
+  const_iterator cbegin() const { return keys_.begin(); }
+  const_iterator cend() const { return keys_.end(); }
+
+  /* capacity */
+  bool empty() const { return keys_.empty(); }
+  size_type size() const { return keys_.size(); }
+  size_type max_size() const { return keys_.size(); }
+
+  /* lookup */
+  template <class KeyType>
+  std::size_t count(KeyType const &key) const {
+    return find(key) != end();
+  }
+
+  template <class KeyType>
+  const_iterator find(KeyType const &key) const {
+    auto const pos = tables_.lookup(key, hash_function());
+    auto it = keys_.begin() + pos;
+    if (it != keys_.end() && key_eq()(*it, key))
+      return it;
+    else
+      return keys_.end();
+  }
+
+  // Same as find, for a key whose base hash was already computed, e.g. by an
+  // incremental_elsa state_type: the key is not hashed again.
+  template <class KeyType>
+  const_iterator find_hashed(KeyType const &key, std::uint64_t hash) const {
+    auto const pos = tables_.lookup(key, bits::prehashed<Hash>{hash_function(), hash});
+    auto it = keys_.begin() + pos;
+    if (it != keys_.end() && key_eq()(*it, key))
+      return it;
+    else
+      return keys_.end();
+  }
+
+  template <class KeyType>
+  bool contains(KeyType const &key) const {
+    return this->find(key) != keys_.end();
+  }
+
+  // Index of the given key, size() if there is none.
+  template <class KeyType>
+  std::size_t index_of(KeyType const &key) const {
+    return static_cast<std::size_t>(find(key) - begin());
+  }
+
+  template <class KeyType>
+  std::pair<const_iterator, const_iterator> equal_range(KeyType const &key) const {
+    auto const it = find(key);
+    if (it != end())
+      return {it, it + 1};
+    else
+      return {keys_.end(), keys_.end()};
+  }
+
+  /* rebuild */
+
+  // Copy of this set, with the keys in [erase_first, erase_last) erased then
+  // the keys in [first, last) inserted, see dynamic_unordered_map::rebuild.
+  template <class InputIt, class KeyIt>
+  dynamic_unordered_set rebuild(InputIt first, InputIt last,
+                                KeyIt erase_first, KeyIt erase_last) const {
+    std::vector<std::size_t> removed;
+    for (; erase_first != erase_last; ++erase_first) {
+      auto const where = find(*erase_first);
+      if (where != end())
+        removed.push_back(where - begin());
+    }
+    std::sort(removed.begin(), removed.end());
+    removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+
+    container_type inserted;
+    for (; first != last; ++first) {
+      auto const where = find(*first);
+      if (where == end()) {
+        inserted.push_back(*first);
+        continue;
+      }
+      // Erased then inserted keys are kept.
+      auto const erased = std::lower_bound(removed.begin(), removed.end(), where - begin());
+      if (erased != removed.end() && *erased == static_cast<std::size_t>(where - begin()))
+        removed.erase(erased);
+    }
+
+    // New keys given several times are added once.
+    container_type added;
+    for (auto const i : bits::pmh_last_of_each_key(inserted, hash_function(), key_eq(), bits::Get{}))
+      added.push_back(inserted[i]);
+
+    container_type keys;
+    keys.reserve(keys_.size() - removed.size() + added.size());
+    auto const moves = bits::pmh_swap_fill(keys_.size(), removed);
+    for (std::size_t i = 0, next = 0, kept = keys_.size() - removed.size(); i < kept; ++i) {
+      if (next < moves.size() && moves[next].second == i)
+        keys.push_back(keys_[moves[next++].first]);
+      else
+        keys.push_back(keys_[i]);
+    }
+    std::size_t const kept = keys.size();
+    keys.insert(keys.end(), added.begin(), added.end());
+
+    auto tables = bits::rebuild_pmh_tables(tables_, keys_, removed, keys, kept,
+                                           hash_function(), key_eq(),
+                                           bits::Get{}, default_prg_t{});
+    return {std::move(keys), std::move(tables), key_eq()};
+  }
+  template <class InputIt>
+  dynamic_unordered_set rebuild(InputIt first, InputIt last) const {
+    key_type const *none = nullptr;
+    return rebuild(first, last, none, none);
+  }
+
+  /* bucket interface */
+  std::size_t bucket_count() const { return tables_.size(); }
+  std::size_t max_bucket_count() const { return tables_.size(); }
+
+  /* observers*/
+  const hasher& hash_function() const { return tables_.hash_function(); }
+  const key_equal& key_eq() const { return static_cast<KeyEqual const&>(*this); }
+
+private:
+  dynamic_unordered_set(container_type &&keys, tables_type &&tables, KeyEqual const &equal)
+      : KeyEqual{equal}, keys_(std::move(keys)), tables_(std::move(tables)) {}
+};
+
+} // namespace frozen
+
+#endif
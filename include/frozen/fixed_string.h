@@ -0,0 +1,170 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_FIXED_STRING_H
+#define FROZEN_LETITGO_FIXED_STRING_H
+
+#include "frozen/bits/defines.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/bits/version.h"
+#include "frozen/string.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef FROZEN_LETITGO_HAS_STRING_VIEW
+#include <string_view>
+#endif
+
+namespace frozen {
+
+// String of at most `Capacity` characters, stored inline rather than behind
+// a pointer. The characters are packed in 64-bit words, first character in
+// the most significant bits, and zero padded, so that equality and ordering
+// compare whole words and hashing has no tail loop. Characters are ordered as
+// unsigned values, as std::char_traits does.
+template <typename _CharT, std::size_t Capacity>
+class basic_fixed_string {
+  using chr_t = _CharT;
+  using uchr_t = std::make_unsigned_t<chr_t>;
+
+  static constexpr std::size_t chars_per_word = 8 / sizeof(chr_t);
+  static constexpr std::size_t bits_per_char = 8 * sizeof(chr_t);
+
+public:
+  static constexpr std::size_t word_count =
+      Capacity ? (Capacity + chars_per_word - 1) / chars_per_word : 1;
+
+private:
+  std::uint64_t words_[word_count] = {};
+  std::size_t size_ = 0;
+
+  static constexpr std::size_t shift(std::size_t i) {
+    return bits_per_char * (chars_per_word - 1 - i % chars_per_word);
+  }
+
+public:
+  constexpr basic_fixed_string() = default;
+
+  template <std::size_t N>
+  constexpr basic_fixed_string(chr_t const (&data)[N])
+      : basic_fixed_string(data, N - 1) {
+    static_assert(N - 1 <= Capacity, "string literal longer than the fixed string capacity");
+  }
+  constexpr basic_fixed_string(chr_t const *data, std::size_t size) : size_(size) {
+    if (size > Capacity)
+      FROZEN_THROW_OR_ABORT(std::length_error("string longer than the fixed string capacity"));
+    for (std::size_t i = 0; i < size; ++i)
+      words_[i / chars_per_word] |= static_cast<std::uint64_t>(static_cast<uchr_t>(data[i])) << shift(i);
+  }
+  constexpr basic_fixed_string(basic_string<chr_t> data)
+      : basic_fixed_string(data.data(), data.size()) {}
+
+#ifdef FROZEN_LETITGO_HAS_STRING_VIEW
+  constexpr basic_fixed_string(std::basic_string_view<chr_t> data)
+      : basic_fixed_string(data.data(), data.size()) {}
+#endif
+
+  static constexpr std::size_t capacity() { return Capacity; }
+  constexpr std::size_t length() const { return size_; }
+  constexpr std::size_t size() const { return size_; }
+  constexpr bool empty() const { return !size_; }
+
+  constexpr chr_t operator[](std::size_t i) const {
+    return static_cast<chr_t>(static_cast<uchr_t>(words_[i / chars_per_word] >> shift(i)));
+  }
+
+  // The packed characters, for hashing.
+  constexpr std::uint64_t word(std::size_t i) const { return words_[i]; }
+
+  constexpr bool operator==(basic_fixed_string const &other) const {
+    for (std::size_t i = 0; i < word_count; ++i)
+      if (words_[i] != other.words_[i])
+        return false;
+    return size_ == other.size_;
+  }
+
+  constexpr bool operator<(basic_fixed_string const &other) const {
+    for (std::size_t i = 0; i < word_count; ++i)
+      if (words_[i] != other.words_[i])
+        return words_[i] < other.words_[i];
+    return size_ < other.size_;
+  }
+
+  friend constexpr bool operator!=(const basic_fixed_string& lhs, const basic_fixed_string& rhs) {
+    return !(lhs == rhs);
+  }
+  friend constexpr bool operator>(const basic_fixed_string& lhs, const basic_fixed_string& rhs) {
+    return rhs < lhs;
+  }
+  friend constexpr bool operator>=(const basic_fixed_string& lhs, const basic_fixed_string& rhs) {
+    return !(lhs < rhs);
+  }
+  friend constexpr bool operator<=(const basic_fixed_string& lhs, const basic_fixed_string& rhs) {
+    return !(lhs > rhs);
+  }
+};
+
+template <typename _CharT, std::size_t Capacity>
+struct elsa<basic_fixed_string<_CharT, Capacity>> {
+  constexpr std::size_t operator()(basic_fixed_string<_CharT, Capacity> const &value) const {
+    return (*this)(value, 0);
+  }
+  // One multiply and xor-shift per word, plus a final one: short keys only
+  // differ in the high bits of their words, and a product alone never
+  // carries them down to the low bits used to pick a slot.
+  constexpr std::size_t operator()(basic_fixed_string<_CharT, Capacity> const &value, std::size_t seed) const {
+    std::uint64_t d = seed ^ (value.size() * 0x9E3779B97F4A7C15ull);
+    for (std::size_t i = 0; i < basic_fixed_string<_CharT, Capacity>::word_count; ++i) {
+      d = (d ^ value.word(i)) * 0x9E3779B97F4A7C15ull;
+      d ^= d >> 32;
+    }
+    d *= 0xBF58476D1CE4E5B9ull;
+    d ^= d >> 29;
+    return static_cast<std::size_t>(d);
+  }
+};
+
+template <std::size_t Capacity> using fixed_string = basic_fixed_string<char, Capacity>;
+template <std::size_t Capacity> using fixed_wstring = basic_fixed_string<wchar_t, Capacity>;
+template <std::size_t Capacity> using fixed_u16string = basic_fixed_string<char16_t, Capacity>;
+template <std::size_t Capacity> using fixed_u32string = basic_fixed_string<char32_t, Capacity>;
+
+#ifdef FROZEN_LETITGO_HAS_CHAR8T
+template <std::size_t Capacity> using fixed_u8string = basic_fixed_string<char8_t, Capacity>;
+#endif
+
+} // namespace frozen
+
+namespace std {
+template <typename _CharT, std::size_t Capacity> struct hash<frozen::basic_fixed_string<_CharT, Capacity>> {
+  std::size_t operator()(frozen::basic_fixed_string<_CharT, Capacity> const &s) const {
+    return frozen::elsa<frozen::basic_fixed_string<_CharT, Capacity>>{}(s);
+  }
+};
+} // namespace std
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_HARDWARE_HASH_H
+#define FROZEN_LETITGO_HARDWARE_HASH_H
+
+#include "frozen/bits/hardware_hash.h"
+#include "frozen/string.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace frozen {
+
+// Seeded hash built on the CRC32C instruction of x86-64 (SSE 4.2) and AArch64,
+// for integers and frozen strings, read 8 bytes at a time. Computed in
+// software at compile time, and at runtime when the target lacks the
+// instruction, with the same results.
+template <class T = void> struct crc_hash {
+  static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                "only supports integral types and frozen strings");
+
+  constexpr std::size_t operator()(T const &value, std::size_t seed) const {
+    return static_cast<std::size_t>(
+        bits::crc_finish(bits::crc_step(bits::crc_start(seed), static_cast<std::uint64_t>(value))));
+  }
+};
+
+template <class CharT> struct crc_hash<basic_string<CharT>> {
+  constexpr std::size_t operator()(basic_string<CharT> value, std::size_t seed) const {
+    return static_cast<std::size_t>(
+        bits::crc_finish(bits::crc_string(bits::crc_start(seed), value.data(), value.size())));
+  }
+};
+
+// Seeded hash built on the AES round instruction of x86-64 (AES-NI) and
+// AArch64: two rounds for integers, one per 16 bytes plus two for frozen
+// strings. Same software fallback as crc_hash.
+template <class T = void> struct aes_hash {
+  static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                "only supports integral types and frozen strings");
+
+  constexpr std::size_t operator()(T const &value, std::size_t seed) const {
+    return static_cast<std::size_t>(bits::aes_finish({static_cast<std::uint64_t>(value), seed}));
+  }
+};
+
+template <class CharT> struct aes_hash<basic_string<CharT>> {
+  constexpr std::size_t operator()(basic_string<CharT> value, std::size_t seed) const {
+    return static_cast<std::size_t>(bits::aes_string(bits::aes_block{seed, value.size()}, value.data(), value.size()));
+  }
+};
+
+} // namespace frozen
+
+#endif
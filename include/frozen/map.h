@@ -157,6 +157,12 @@ public:
   constexpr bool contains(KeyType const &key) const {
     return this->find(key) != this->end();
   }
+
+  // Index of the item with the given key, size() if there is none.
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &key) const {
+    return static_cast<std::size_t>(find(key) - begin());
+  }
   
   template <class KeyType>
   constexpr std::pair<const_iterator, const_iterator>
@@ -303,6 +309,9 @@ public:
   template <class KeyType>
   constexpr iterator find(KeyType const &) { return end(); }
 
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &) const { return 0; }
+
   template <class KeyType>
   constexpr std::pair<const_iterator, const_iterator>
   equal_range(KeyType const &) const { return {end(), end()}; }
@@ -0,0 +1,386 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_MAPPED_UNORDERED_MAP_H
+#define FROZEN_LETITGO_MAPPED_UNORDERED_MAP_H
+
+#include "frozen/bits/dynamic_pmh.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/dynamic_unordered_map.h"
+#include "frozen/string.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+namespace bits {
+
+// Binary image of a perfect hash map, as written by frozen::serialize. All
+// sections start on a mapped_alignment boundary, at the offsets recorded in
+// the header, and use the native byte order:
+//
+//   header | shards | G | H | key offsets | keys | values
+//
+// Shards are (first seed, offset, mask) triples, G and H entries are 64 bit.
+// Fixed size keys are stored as is, string keys as a single character blob
+// indexed by count + 1 offsets.
+constexpr std::size_t mapped_alignment = 16;
+constexpr std::uint32_t mapped_version = 1;
+constexpr std::uint32_t mapped_byte_order = 0x01020304;
+
+struct mapped_header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t key_kind;
+  std::uint32_t key_size;
+  std::uint32_t value_size;
+  std::uint32_t value_align;
+  std::uint64_t count;
+  std::uint64_t slots;
+  std::uint64_t shard_count;
+  std::uint64_t shard_seed;
+  std::uint64_t shards_offset;
+  std::uint64_t first_table_offset;
+  std::uint64_t second_table_offset;
+  std::uint64_t key_offsets_offset;
+  std::uint64_t keys_offset;
+  std::uint64_t values_offset;
+  std::uint64_t size;
+  std::uint64_t checksum;
+};
+
+constexpr char mapped_magic[8] = {'f', 'r', 'o', 'z', 'e', 'n', 'P', 'H'};
+
+// FNV-1a over every field of the header but the checksum itself.
+inline std::uint64_t mapped_checksum(mapped_header const &header) {
+  unsigned char const *bytes = reinterpret_cast<unsigned char const *>(&header);
+  std::uint64_t d = 0xcbf29ce484222325ull;
+  for (std::size_t i = 0; i < offsetof(mapped_header, checksum); ++i)
+    d = (d ^ bytes[i]) * 0x100000001b3ull;
+  return d;
+}
+
+constexpr std::uint64_t mapped_align(std::uint64_t offset) {
+  return (offset + mapped_alignment - 1) & ~std::uint64_t(mapped_alignment - 1);
+}
+
+// How keys of type Key are laid out in the image. Fixed size keys are copied
+// into an array.
+template <class Key>
+struct mapped_key_traits {
+  static_assert(std::is_trivially_copyable<Key>::value,
+                "only trivially copyable or frozen::basic_string keys can be mapped");
+  static_assert(alignof(Key) <= mapped_alignment, "over-aligned keys cannot be mapped");
+
+  static constexpr std::uint32_t kind = 0;
+  static constexpr std::uint32_t unit = sizeof(Key);
+
+  template <class Items>
+  static std::uint64_t index_size(Items const &) { return 0; }
+  template <class Items>
+  static std::uint64_t keys_size(Items const &items) { return items.size() * sizeof(Key); }
+
+  template <class Items>
+  static void write(Items const &items, unsigned char *, unsigned char *keys) {
+    for (auto const &item : items) {
+      std::memcpy(keys, &item.first, sizeof(Key));
+      keys += sizeof(Key);
+    }
+  }
+
+  static Key const &read(unsigned char const *, unsigned char const *keys, std::size_t i) {
+    return reinterpret_cast<Key const *>(keys)[i];
+  }
+};
+
+// String keys are views on a character blob.
+template <class CharT>
+struct mapped_key_traits<basic_string<CharT>> {
+  static constexpr std::uint32_t kind = 1;
+  static constexpr std::uint32_t unit = sizeof(CharT);
+
+  template <class Items>
+  static std::uint64_t index_size(Items const &items) { return (items.size() + 1) * sizeof(std::uint64_t); }
+  template <class Items>
+  static std::uint64_t keys_size(Items const &items) {
+    std::uint64_t size = 0;
+    for (auto const &item : items)
+      size += item.first.size() * sizeof(CharT);
+    return size;
+  }
+
+  template <class Items>
+  static void write(Items const &items, unsigned char *index, unsigned char *keys) {
+    std::uint64_t offset = 0;
+    std::memcpy(index, &offset, sizeof(offset));
+    for (auto const &item : items) {
+      if (item.first.size())
+        std::memcpy(keys + offset * sizeof(CharT), item.first.data(), item.first.size() * sizeof(CharT));
+      offset += item.first.size();
+      index += sizeof(offset);
+      std::memcpy(index, &offset, sizeof(offset));
+    }
+  }
+
+  static basic_string<CharT> read(unsigned char const *index, unsigned char const *keys, std::size_t i) {
+    auto const *offsets = reinterpret_cast<std::uint64_t const *>(index);
+    return {reinterpret_cast<CharT const *>(keys) + offsets[i],
+            static_cast<std::size_t>(offsets[i + 1] - offsets[i])};
+  }
+};
+
+// View of a mapped G table, compatible with pmh_lookup.
+struct mapped_seed_table {
+  std::uint64_t const *entries;
+  seed_or_index operator[](std::size_t i) const {
+    return {(entries[i] >> 63) != 0, entries[i]};
+  }
+};
+
+struct pmh_serializer {
+  template <class Key, class Value, class Hash, class KeyEqual>
+  static std::vector<unsigned char> write(dynamic_unordered_map<Key, Value, Hash, KeyEqual> const &map) {
+    static_assert(std::is_trivially_copyable<Value>::value, "only trivially copyable values can be mapped");
+    static_assert(alignof(Value) <= mapped_alignment, "over-aligned values cannot be mapped");
+    using key_traits = mapped_key_traits<Key>;
+    auto const &items = map;
+    auto const &tables = pmh_access::tables(map);
+
+    mapped_header header{};
+    std::memcpy(header.magic, mapped_magic, sizeof(header.magic));
+    header.version = mapped_version;
+    header.byte_order = mapped_byte_order;
+    header.key_kind = key_traits::kind;
+    header.key_size = key_traits::unit;
+    header.value_size = sizeof(Value);
+    header.value_align = alignof(Value);
+    header.count = items.size();
+    header.slots = tables.size();
+    header.shard_count = tables.shards().size();
+    header.shard_seed = tables.shard_seed();
+    header.shards_offset = mapped_align(sizeof(mapped_header));
+    header.first_table_offset = mapped_align(header.shards_offset + header.shard_count * 3 * sizeof(std::uint64_t));
+    header.second_table_offset = mapped_align(header.first_table_offset + header.slots * sizeof(std::uint64_t));
+    header.key_offsets_offset = mapped_align(header.second_table_offset + header.slots * sizeof(std::uint64_t));
+    header.keys_offset = mapped_align(header.key_offsets_offset + key_traits::index_size(items));
+    header.values_offset = mapped_align(header.keys_offset + key_traits::keys_size(items));
+    header.size = mapped_align(header.values_offset + header.count * sizeof(Value));
+    header.checksum = mapped_checksum(header);
+
+    std::vector<unsigned char> image(static_cast<std::size_t>(header.size));
+    unsigned char *const base = image.data();
+    std::memcpy(base, &header, sizeof(header));
+
+    auto *shards = base + header.shards_offset;
+    for (auto const &shard : tables.shards()) {
+      std::uint64_t const entry[3] = {shard.first_seed, shard.offset, shard.mask};
+      std::memcpy(shards, entry, sizeof(entry));
+      shards += sizeof(entry);
+    }
+    for (std::size_t i = 0; i < tables.size(); ++i) {
+      std::uint64_t const first = tables.first_table()[i].value();
+      std::uint64_t const second = tables.second_table()[i];
+      std::memcpy(base + header.first_table_offset + i * sizeof(first), &first, sizeof(first));
+      std::memcpy(base + header.second_table_offset + i * sizeof(second), &second, sizeof(second));
+    }
+    key_traits::write(items, base + header.key_offsets_offset, base + header.keys_offset);
+    for (std::size_t i = 0; i < items.size(); ++i)
+      std::memcpy(base + header.values_offset + i * sizeof(Value), &items.begin()[i].second, sizeof(Value));
+    return image;
+  }
+};
+
+} // namespace bits
+
+// Writes the binary image of `map`, to be opened by a mapped_unordered_map of
+// the same Key, Value and Hash, possibly from another process.
+template <class Key, class Value, class Hash, class KeyEqual>
+std::vector<unsigned char> serialize(dynamic_unordered_map<Key, Value, Hash, KeyEqual> const &map) {
+  return bits::pmh_serializer::write(map);
+}
+
+// Read-only view of a map written by frozen::serialize, typically mapped from
+// a file. Opening the view only validates the header: lookups run directly on
+// the image, which must outlive the view, be aligned on a 16 bytes boundary,
+// and be trusted past its header.
+template <class Key, class Value, typename Hash = anna<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class mapped_unordered_map : private KeyEqual {
+  using key_traits = bits::mapped_key_traits<Key>;
+
+  Hash hash_;
+  std::size_t size_ = 0;
+  std::size_t slots_ = 0;
+  std::uint64_t shard_seed_ = 0;
+  std::size_t shard_mask_ = 0;
+  std::uint64_t const *shards_ = nullptr;
+  std::uint64_t const *first_table_ = nullptr;
+  std::uint64_t const *second_table_ = nullptr;
+  unsigned char const *key_offsets_ = nullptr;
+  unsigned char const *keys_ = nullptr;
+  Value const *values_ = nullptr;
+
+public:
+  /* typedefs */
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<decltype(key_traits::read(nullptr, nullptr, 0)), Value const &>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  class const_iterator {
+    mapped_unordered_map const *map_ = nullptr;
+    std::size_t index_ = 0;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename mapped_unordered_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+    using pointer = void;
+
+    const_iterator() = default;
+    const_iterator(mapped_unordered_map const *map, std::size_t index) : map_(map), index_(index) {}
+
+    value_type operator*() const { return {map_->key_at(index_), map_->values_[index_]}; }
+    const_iterator &operator++() { ++index_; return *this; }
+    const_iterator operator++(int) { auto self = *this; ++index_; return self; }
+    bool operator==(const_iterator const &other) const { return index_ == other.index_; }
+    bool operator!=(const_iterator const &other) const { return index_ != other.index_; }
+  };
+  using iterator = const_iterator;
+
+public:
+  /* constructors */
+  mapped_unordered_map(void const *image, std::size_t size, Hash const &hash, KeyEqual const &equal)
+      : KeyEqual{equal}, hash_(hash) {
+    auto const *base = static_cast<unsigned char const *>(image);
+    if (reinterpret_cast<std::uintptr_t>(base) % bits::mapped_alignment)
+      FROZEN_THROW_OR_ABORT(std::invalid_argument("misaligned frozen image"));
+    if (size < sizeof(bits::mapped_header))
+      FROZEN_THROW_OR_ABORT(std::invalid_argument("truncated frozen image"));
+
+    auto const &header = *static_cast<bits::mapped_header const *>(image);
+    if (std::memcmp(header.magic, bits::mapped_magic, sizeof(header.magic)) ||
+        header.version != bits::mapped_version ||
+        header.byte_order != bits::mapped_byte_order ||
+        header.checksum != bits::mapped_checksum(header))
+      FROZEN_THROW_OR_ABORT(std::invalid_argument("invalid frozen image header"));
+    if (header.key_kind != key_traits::kind || header.key_size != key_traits::unit ||
+        header.value_size != sizeof(Value) || header.value_align != alignof(Value))
+      FROZEN_THROW_OR_ABORT(std::invalid_argument("frozen image of another map type"));
+    if (header.size > size || header.values_offset + header.count * sizeof(Value) > header.size ||
+        header.shard_count == 0 || (header.shard_count & (header.shard_count - 1)))
+      FROZEN_THROW_OR_ABORT(std::invalid_argument("truncated frozen image"));
+
+    size_ = static_cast<std::size_t>(header.count);
+    slots_ = static_cast<std::size_t>(header.slots);
+    shard_seed_ = header.shard_seed;
+    shard_mask_ = static_cast<std::size_t>(header.shard_count - 1);
+    shards_ = reinterpret_cast<std::uint64_t const *>(base + header.shards_offset);
+    first_table_ = reinterpret_cast<std::uint64_t const *>(base + header.first_table_offset);
+    second_table_ = reinterpret_cast<std::uint64_t const *>(base + header.second_table_offset);
+    key_offsets_ = base + header.key_offsets_offset;
+    keys_ = base + header.keys_offset;
+    values_ = reinterpret_cast<Value const *>(base + header.values_offset);
+  }
+  mapped_unordered_map(void const *image, std::size_t size)
+      : mapped_unordered_map{image, size, Hash{}, KeyEqual{}} {}
+
+  /* iterators */
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, size_}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  /* capacity */
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+  size_type max_size() const { return size_; }
+
+  /* lookup */
+  template <class KeyType>
+  std::size_t count(KeyType const &key) const {
+    return find(key) != end();
+  }
+
+  template <class KeyType>
+  Value const &at(KeyType const &key) const {
+    auto const index = index_of(key);
+    if (index == size_)
+      FROZEN_THROW_OR_ABORT(std::out_of_range("unknown key"));
+    return values_[index];
+  }
+
+  template <class KeyType>
+  const_iterator find(KeyType const &key) const {
+    return {this, index_of(key)};
+  }
+
+  template <class KeyType>
+  bool contains(KeyType const &key) const {
+    return index_of(key) != size_;
+  }
+
+  // Index of the item with the given key, size() if there is none.
+  template <class KeyType>
+  std::size_t index_of(KeyType const &key) const {
+    std::uint64_t const *shard = shards_;
+    if (shard_mask_)
+      shard += 3 * bits::pmh_shard_of(hash_(key, static_cast<std::size_t>(shard_seed_)), shard_mask_);
+    auto const offset = static_cast<std::size_t>(shard[1]);
+    std::size_t const index = bits::pmh_lookup(
+        key, hash_, shard[0], bits::mapped_seed_table{first_table_ + offset},
+        second_table_ + offset, static_cast<std::size_t>(shard[2]));
+    if (index < size_ && key_eq()(key_at(index), key))
+      return index;
+    return size_;
+  }
+
+  /* bucket interface */
+  std::size_t bucket_count() const { return slots_; }
+  std::size_t max_bucket_count() const { return slots_; }
+
+  /* observers*/
+  const hasher& hash_function() const { return hash_; }
+  const key_equal& key_eq() const { return static_cast<KeyEqual const&>(*this); }
+
+private:
+  decltype(key_traits::read(nullptr, nullptr, 0)) key_at(std::size_t index) const {
+    return key_traits::read(key_offsets_, keys_, index);
+  }
+};
+
+} // namespace frozen
+
+#endif
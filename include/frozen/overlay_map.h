@@ -0,0 +1,224 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_OVERLAY_MAP_H
+#define FROZEN_LETITGO_OVERLAY_MAP_H
+
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/dynamic_unordered_map.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+// A frozen::map or frozen::unordered_map, plus a small mutable overlay of
+// inserted, overridden and erased keys. The base map is referenced, not
+// copied, and must outlive the overlay_map.
+//
+// The overlay is an open addressing table of indices into a list of records.
+// A record either holds the current value of a key, or marks the key as
+// erased. Records are only dropped by `clear_overlay()`. As long as the
+// overlay is empty, lookups go straight to the base map.
+template <class Base, class Hash = elsa<typename Base::key_type>,
+          class KeyEqual = std::equal_to<typename Base::key_type>>
+class overlay_map : private KeyEqual {
+public:
+  /* typedefs */
+  using base_type = Base;
+  using key_type = typename Base::key_type;
+  using mapped_type = typename Base::mapped_type;
+  using value_type = std::pair<key_type, mapped_type>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+private:
+  struct record {
+    value_type item;
+    bool present;
+  };
+
+  Base const *base_;
+  Hash hash_;
+  std::size_t size_;
+  std::vector<record> records_;
+  std::vector<std::uint32_t> slots_; // 1 + index in records_, 0 if free
+
+public:
+  /* constructors */
+  explicit overlay_map(Base const &base, Hash const &hash = Hash{}, KeyEqual const &equal = KeyEqual{})
+      : KeyEqual{equal}, base_(&base), hash_(hash), size_(base.size()) {}
+
+  /* capacity */
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+
+  // Number of keys inserted, overridden or erased since the last clear.
+  size_type overlay_size() const { return records_.size(); }
+
+  /* lookup */
+  template <class KeyType>
+  std::size_t count(KeyType const &key) const {
+    return find(key) != nullptr;
+  }
+
+  template <class KeyType>
+  bool contains(KeyType const &key) const {
+    return find(key) != nullptr;
+  }
+
+  // Pointer to the current value of `key`, nullptr if there is none.
+  template <class KeyType>
+  mapped_type const *find(KeyType const &key) const {
+    if (!records_.empty()) {
+      if (record const *overlaid = find_record(key))
+        return overlaid->present ? &overlaid->item.second : nullptr;
+    }
+    auto const where = base_->find(key);
+    return where != base_->end() ? &where->second : nullptr;
+  }
+
+  template <class KeyType>
+  mapped_type const &at(KeyType const &key) const {
+    if (mapped_type const *value = find(key))
+      return *value;
+    FROZEN_THROW_OR_ABORT(std::out_of_range("unknown key"));
+  }
+
+  /* modifiers */
+
+  // Inserts `key`, or overrides its value. Returns true if the key was not in
+  // the map.
+  bool insert_or_assign(key_type const &key, mapped_type const &value) {
+    if (record *overlaid = find_record(key)) {
+      overlaid->item.second = value;
+      bool const inserted = !overlaid->present;
+      overlaid->present = true;
+      size_ += inserted;
+      return inserted;
+    }
+    bool const inserted = base_->find(key) == base_->end();
+    add_record(key, value, true);
+    size_ += inserted;
+    return inserted;
+  }
+
+  // Removes `key`, base key or not. Returns the number of erased keys.
+  template <class KeyType>
+  std::size_t erase(KeyType const &key) {
+    if (record *overlaid = find_record(key)) {
+      bool const erased = overlaid->present;
+      overlaid->present = false;
+      size_ -= erased;
+      return erased;
+    }
+    auto const where = base_->find(key);
+    if (where == base_->end())
+      return 0;
+    add_record(where->first, where->second, false);
+    size_ -= 1;
+    return 1;
+  }
+
+  // Goes back to the base map.
+  void clear_overlay() {
+    records_.clear();
+    slots_.clear();
+    size_ = base_->size();
+  }
+
+  // Merges the base map and the overlay into a new runtime table.
+  template <class Table = dynamic_unordered_map<key_type, mapped_type, Hash, KeyEqual>>
+  Table freeze() const {
+    std::vector<value_type> items;
+    items.reserve(size_);
+    for (auto const &item : *base_)
+      if (records_.empty() || !find_record(item.first))
+        items.emplace_back(item.first, item.second);
+    for (auto const &overlaid : records_)
+      if (overlaid.present)
+        items.push_back(overlaid.item);
+    return Table(items.begin(), items.end());
+  }
+
+  /* observers*/
+  base_type const &base() const { return *base_; }
+  const hasher& hash_function() const { return hash_; }
+  const key_equal& key_eq() const { return static_cast<KeyEqual const&>(*this); }
+
+private:
+  template <class KeyType>
+  std::size_t first_slot(KeyType const &key) const {
+    return hash_(key, 0) & (slots_.size() - 1);
+  }
+
+  template <class KeyType>
+  record const *find_record(KeyType const &key) const {
+    if (slots_.empty())
+      return nullptr;
+    for (std::size_t slot = first_slot(key);; slot = (slot + 1) & (slots_.size() - 1)) {
+      auto const index = slots_[slot];
+      if (!index)
+        return nullptr;
+      if (key_eq()(records_[index - 1].item.first, key))
+        return &records_[index - 1];
+    }
+  }
+
+  template <class KeyType>
+  record *find_record(KeyType const &key) {
+    return const_cast<record *>(static_cast<overlay_map const &>(*this).find_record(key));
+  }
+
+  void add_record(key_type const &key, mapped_type const &value, bool present) {
+    records_.push_back({{key, value}, present});
+    // Keep the load factor at or below one half.
+    if (2 * records_.size() > slots_.size()) {
+      slots_.assign(slots_.empty() ? 16 : 2 * slots_.size(), 0);
+      for (std::size_t i = 0; i < records_.size(); ++i)
+        place(records_[i].item.first, static_cast<std::uint32_t>(i + 1));
+    } else {
+      place(key, static_cast<std::uint32_t>(records_.size()));
+    }
+  }
+
+  void place(key_type const &key, std::uint32_t index) {
+    std::size_t slot = first_slot(key);
+    while (slots_[slot])
+      slot = (slot + 1) & (slots_.size() - 1);
+    slots_[slot] = index;
+  }
+};
+
+template <class Base>
+overlay_map<Base> make_overlay_map(Base const &base) {
+  return overlay_map<Base>(base);
+}
+
+} // namespace frozen
+
+#endif
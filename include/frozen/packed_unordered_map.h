@@ -0,0 +1,239 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_PACKED_UNORDERED_MAP_H
+#define FROZEN_LETITGO_PACKED_UNORDERED_MAP_H
+
+#include "frozen/bits/basic_types.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/exceptions.h"
+#include "frozen/bits/pmh.h"
+#include "frozen/random.h"
+#include "frozen/string.h"
+#include "frozen/unordered_map.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace frozen {
+
+namespace bits {
+
+// Where a key lies in the character blob of a packed_unordered_map.
+struct packed_key {
+  std::uint32_t offset;
+  std::uint32_t size;
+};
+
+template <class Key> struct packed_char;
+template <class CharT> struct packed_char<basic_string<CharT>> { using type = CharT; };
+
+} // namespace bits
+
+// Number of characters in the keys of `items`, to size the blob of a
+// packed_unordered_map.
+template <class Key, class Value, std::size_t N>
+constexpr std::size_t packed_chars(std::pair<Key, Value> const (&items)[N]) {
+  std::size_t chars = 0;
+  for (auto const &item : items)
+    chars += item.first.size();
+  return chars;
+}
+
+// Same as frozen::unordered_map with frozen::basic_string keys, but the key
+// characters are copied into one blob of `Chars` characters within the map,
+// and each key is an (offset, size) pair of 32-bit integers. The map holds no
+// pointer, so a constexpr one needs no load-time relocation in a shared
+// object or a position independent executable, and its pages stay shared.
+template <class Key, class Value, std::size_t N, std::size_t Chars,
+          typename Hash = anna<Key>, class KeyEqual = std::equal_to<Key>>
+class packed_unordered_map : private KeyEqual {
+  static_assert(Chars <= UINT32_MAX, "packed keys are limited to 4G characters");
+
+  using char_type = typename bits::packed_char<Key>::type;
+  static constexpr std::size_t storage_size = bits::pmh_storage_size(N);
+  using container_type = bits::carray<std::pair<Key, Value>, N>;
+  using tables_type = bits::pmh_tables<storage_size, Hash>;
+
+  bits::carray<char_type, Chars> chars_;
+  bits::carray<bits::packed_key, N> keys_;
+  bits::carray<Value, N> values_;
+  tables_type tables_;
+
+public:
+  /* typedefs */
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value const &>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  class const_iterator {
+    packed_unordered_map const *map_ = nullptr;
+    std::size_t index_ = 0;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename packed_unordered_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type;
+    using pointer = void;
+
+    constexpr const_iterator() = default;
+    constexpr const_iterator(packed_unordered_map const *map, std::size_t index) : map_(map), index_(index) {}
+
+    constexpr value_type operator*() const { return {map_->key_at(index_), map_->values_[index_]}; }
+    constexpr const_iterator &operator++() { ++index_; return *this; }
+    constexpr const_iterator operator++(int) { auto self = *this; ++index_; return self; }
+    constexpr bool operator==(const_iterator const &other) const { return index_ == other.index_; }
+    constexpr bool operator!=(const_iterator const &other) const { return index_ != other.index_; }
+  };
+  using iterator = const_iterator;
+
+public:
+  /* constructors */
+  constexpr packed_unordered_map(container_type items, Hash const &hash, KeyEqual const &equal)
+      : KeyEqual{equal}
+      , chars_{pack_chars(items)}
+      , keys_{pack_keys(items)}
+      , values_{pack_values(items, std::make_index_sequence<N>{})}
+      , tables_{bits::make_pmh_tables<storage_size>(
+            items, hash, equal, bits::GetKey{}, default_prg_t{})} {}
+  explicit constexpr packed_unordered_map(container_type items)
+      : packed_unordered_map{items, Hash{}, KeyEqual{}} {}
+
+  constexpr packed_unordered_map(std::initializer_list<std::pair<Key, Value>> items,
+                                 Hash const &hash, KeyEqual const &equal)
+      : packed_unordered_map{container_type{items}, hash, equal} {}
+  constexpr packed_unordered_map(std::initializer_list<std::pair<Key, Value>> items)
+      : packed_unordered_map{items, Hash{}, KeyEqual{}} {}
+
+  /* iterators */
+  constexpr const_iterator begin() const { return {this, 0}; }
+  constexpr const_iterator end() const { return {this, N}; }
+  constexpr const_iterator cbegin() const { return begin(); }
+  constexpr const_iterator cend() const { return end(); }
+
+  /* capacity */
+  constexpr bool empty() const { return !N; }
+  constexpr size_type size() const { return N; }
+  constexpr size_type max_size() const { return N; }
+
+  /* lookup */
+  template <class KeyType>
+  constexpr std::size_t count(KeyType const &key) const {
+    return index_of(key) != N;
+  }
+
+  template <class KeyType>
+  constexpr Value const &at(KeyType const &key) const {
+    return at_impl(*this, key);
+  }
+  template <class KeyType>
+  constexpr Value &at(KeyType const &key) {
+    return at_impl(*this, key);
+  }
+
+  template <class KeyType>
+  constexpr const_iterator find(KeyType const &key) const {
+    return {this, index_of(key)};
+  }
+
+  template <class KeyType>
+  constexpr bool contains(KeyType const &key) const {
+    return index_of(key) != N;
+  }
+
+  // Index of the item with the given key, size() if there is none.
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &key) const {
+    auto const index = tables_.lookup(key, hash_function());
+    if (index < N && key_eq()(key_at(index), key))
+      return index;
+    return N;
+  }
+
+  /* bucket interface */
+  constexpr std::size_t bucket_count() const { return storage_size; }
+  constexpr std::size_t max_bucket_count() const { return storage_size; }
+
+  /* observers*/
+  constexpr const hasher& hash_function() const { return tables_.hash_function(); }
+  constexpr const key_equal& key_eq() const { return static_cast<KeyEqual const&>(*this); }
+
+private:
+  static constexpr bits::carray<char_type, Chars> pack_chars(container_type const &items) {
+    bits::carray<char_type, Chars> chars{};
+    std::size_t offset = 0;
+    for (auto const &item : items) {
+      if (item.first.size() > Chars - offset)
+        FROZEN_THROW_OR_ABORT(std::invalid_argument("the keys have more characters than the blob"));
+      for (std::size_t i = 0; i < item.first.size(); ++i)
+        chars[offset + i] = item.first[i];
+      offset += item.first.size();
+    }
+    return chars;
+  }
+
+  static constexpr bits::carray<bits::packed_key, N> pack_keys(container_type const &items) {
+    bits::carray<bits::packed_key, N> keys{};
+    std::uint32_t offset = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      keys[i] = {offset, static_cast<std::uint32_t>(items[i].first.size())};
+      offset += keys[i].size;
+    }
+    return keys;
+  }
+
+  template <std::size_t... I>
+  static constexpr bits::carray<Value, N> pack_values(container_type const &items, std::index_sequence<I...>) {
+    return bits::carray<Value, N>{items[I].second...};
+  }
+
+  constexpr Key key_at(std::size_t index) const {
+    return {chars_.data() + keys_[index].offset, keys_[index].size};
+  }
+
+  template <class This, class KeyType>
+  static constexpr auto& at_impl(This&& self, KeyType const &key) {
+    auto const index = self.index_of(key);
+    if (index != N)
+      return self.values_[index];
+    else
+      FROZEN_THROW_OR_ABORT(std::out_of_range("unknown key"));
+  }
+};
+
+template <std::size_t Chars, class Key, class Value, std::size_t N>
+constexpr auto make_packed_unordered_map(std::pair<Key, Value> const (&items)[N]) {
+  return packed_unordered_map<Key, Value, N, Chars>{items};
+}
+
+} // namespace frozen
+
+#endif
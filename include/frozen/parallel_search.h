@@ -0,0 +1,138 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_PARALLEL_SEARCH_H
+#define FROZEN_LETITGO_PARALLEL_SEARCH_H
+
+#include "frozen/algorithm.h"
+#include "frozen/bits/parallel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace frozen {
+
+namespace bits {
+
+// Splits [first, last) into chunks searched independently. Each chunk owns
+// the matches starting within it, and is extended by size() - 1 characters so
+// that matches crossing its end are found too.
+template <class RandomAccessIterator>
+class search_chunks {
+  RandomAccessIterator first_, last_;
+  std::size_t count_;
+  std::size_t overlap_;
+
+public:
+  // Chunks smaller than this are not worth a thread hand-off.
+  static constexpr std::size_t min_chunk_size = 1 << 16;
+
+  search_chunks(RandomAccessIterator first, RandomAccessIterator last, std::size_t needle_size, unsigned threads)
+      : first_(first), last_(last), overlap_(needle_size ? needle_size - 1 : 0) {
+    std::size_t const length = last - first;
+    std::size_t const min_size = overlap_ * 16 > min_chunk_size ? overlap_ * 16 : min_chunk_size;
+    std::size_t const max_count = length / min_size;
+    // a few chunks per thread to balance the load
+    std::size_t const wanted = std::size_t(threads) * 4;
+    count_ = wanted < max_count ? wanted : max_count;
+    if (count_ == 0)
+      count_ = 1;
+  }
+
+  std::size_t size() const { return count_; }
+
+  RandomAccessIterator begin(std::size_t i) const {
+    return first_ + static_cast<std::size_t>(last_ - first_) * i / count_;
+  }
+
+  RandomAccessIterator end(std::size_t i) const { return begin(i + 1); }
+
+  // End of the range to search for matches owned by chunk `i`.
+  RandomAccessIterator search_end(std::size_t i) const {
+    auto const stop = end(i);
+    return static_cast<std::size_t>(last_ - stop) > overlap_ ? stop + overlap_ : last_;
+  }
+};
+
+} // namespace bits
+
+// Same as frozen::search, with the haystack split across `threads` threads.
+// Chunks following the one holding a match are skipped.
+template <class RandomAccessIterator, class Searcher>
+RandomAccessIterator parallel_search(RandomAccessIterator first, RandomAccessIterator last,
+                                     Searcher const &searcher,
+                                     unsigned threads = bits::default_thread_count()) {
+  if (searcher.size() == 0)
+    return first;
+
+  bits::search_chunks<RandomAccessIterator> const chunks(first, last, searcher.size(), threads);
+  std::vector<RandomAccessIterator> matches(chunks.size(), last);
+  std::atomic<std::size_t> best{chunks.size()};
+
+  bits::parallel_for(chunks.size(), threads, [&](std::size_t i) {
+    if (i > best.load(std::memory_order_relaxed))
+      return;
+    auto const match = searcher(chunks.begin(i), chunks.search_end(i)).first;
+    if (match == chunks.search_end(i) || !(match < chunks.end(i)))
+      return;
+    matches[i] = match;
+    for (auto current = best.load(); i < current && !best.compare_exchange_weak(current, i);)
+      ;
+  });
+
+  auto const found = best.load();
+  return found == chunks.size() ? last : matches[found];
+}
+
+// Writes an iterator to the start of every match in [first, last), overlapping
+// matches included, to `out`, in increasing order. The haystack is split
+// across `threads` threads.
+template <class RandomAccessIterator, class Searcher, class OutputIterator>
+OutputIterator parallel_find_all(RandomAccessIterator first, RandomAccessIterator last,
+                                 Searcher const &searcher, OutputIterator out,
+                                 unsigned threads = bits::default_thread_count()) {
+  if (searcher.size() == 0)
+    return out;
+
+  bits::search_chunks<RandomAccessIterator> const chunks(first, last, searcher.size(), threads);
+  std::vector<std::vector<RandomAccessIterator>> matches(chunks.size());
+
+  bits::parallel_for(chunks.size(), threads, [&](std::size_t i) {
+    auto const stop = chunks.end(i);
+    for (auto const &match : find_all(chunks.begin(i), chunks.search_end(i), searcher)) {
+      if (!(match.first < stop))
+        break;
+      matches[i].push_back(match.first);
+    }
+  });
+
+  for (auto const &chunk_matches : matches)
+    for (auto const &match : chunk_matches)
+      *out++ = match;
+  return out;
+}
+
+} // namespace frozen
+
+#endif
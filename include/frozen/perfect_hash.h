@@ -0,0 +1,103 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_PERFECT_HASH_H
+#define FROZEN_LETITGO_PERFECT_HASH_H
+
+#include "frozen/bits/basic_types.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/bits/pmh.h"
+#include "frozen/bits/version.h"
+#include "frozen/random.h"
+#include "frozen/unordered_set.h"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+namespace frozen {
+
+// Minimal perfect hash function of N keys: maps each of them to its index in
+// the array it was built from, in [0, N). Only the tables of unordered_set
+// are kept, not the keys, so other keys map to an unspecified index, possibly
+// N: membership must be known some other way.
+template <class Key, std::size_t N, typename Hash = elsa<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class perfect_hash {
+  static constexpr std::size_t storage_size = bits::pmh_storage_size(N);
+  using tables_type = bits::pmh_tables_for<storage_size, Key, Hash>;
+
+  tables_type tables_;
+
+public:
+  /* typedefs */
+  using key_type = Key;
+  using hasher = Hash;
+
+  /* constructors */
+  // `equal` only detects duplicated keys while building.
+  constexpr perfect_hash(bits::carray<Key, N> const &keys, Hash const &hash,
+                         KeyEqual const &equal)
+      : tables_{bits::make_tables(bits::tables_tag<tables_type>{},
+            keys, hash, equal, bits::Get{}, default_prg_t{})} {}
+  explicit constexpr perfect_hash(bits::carray<Key, N> const &keys)
+      : perfect_hash{keys, Hash{}, KeyEqual{}} {}
+
+  /* lookup */
+  template <class KeyType>
+  constexpr std::size_t operator()(KeyType const &key) const {
+    return tables_.lookup(key, hash_function());
+  }
+
+  /* capacity */
+  constexpr std::size_t size() const { return N; }
+
+  /* bucket interface */
+  constexpr std::size_t bucket_count() const { return storage_size; }
+
+  /* observers*/
+  constexpr const hasher& hash_function() const { return tables_.hash_function(); }
+};
+
+template <typename T, std::size_t N>
+constexpr auto make_perfect_hash(T const (&keys)[N]) {
+  return perfect_hash<T, N>{keys};
+}
+
+template <typename T, std::size_t N, typename Hasher, typename Equal>
+constexpr auto make_perfect_hash(T const (&keys)[N], Hasher const &hash, Equal const &equal) {
+  return perfect_hash<T, N, Hasher, Equal>{keys, hash, equal};
+}
+
+template <typename T, std::size_t N>
+constexpr auto make_perfect_hash(std::array<T, N> const &keys) {
+  return perfect_hash<T, N>{keys};
+}
+
+template <typename T, std::size_t N, typename Hasher, typename Equal>
+constexpr auto make_perfect_hash(std::array<T, N> const &keys, Hasher const &hash, Equal const &equal) {
+  return perfect_hash<T, N, Hasher, Equal>{keys, hash, equal};
+}
+
+} // namespace frozen
+
+#endif
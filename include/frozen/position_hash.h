@@ -0,0 +1,196 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_POSITION_HASH_H
+#define FROZEN_LETITGO_POSITION_HASH_H
+
+#include "frozen/bits/algorithms.h"
+#include "frozen/bits/basic_types.h"
+#include "frozen/bits/elsa.h"
+#include "frozen/string.h"
+#include "frozen/unordered_map.h"
+#include "frozen/unordered_set.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+namespace frozen {
+
+namespace bits {
+
+// At most that many character positions are hashed, taken among the first
+// and last position_hash_window characters of the keys.
+constexpr std::size_t position_hash_positions = 4;
+constexpr std::ptrdiff_t position_hash_window = 16;
+
+// The length of `key` and its characters at `positions`, a position p >= 0
+// counting from the start and p < 0 from the end. Only the low 8 bits of each
+// character and 15 of the length are kept: keys told apart by the signature
+// are told apart by their full characters too.
+template <class CharT>
+constexpr std::uint64_t position_signature(basic_string<CharT> key, std::ptrdiff_t const *positions,
+                                           std::size_t count) {
+  std::uint64_t signature = static_cast<std::uint64_t>(key.size() & 0x7FFF) << 48;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::ptrdiff_t const p = positions[i];
+    std::size_t const distance = static_cast<std::size_t>(p < 0 ? -p : p);
+    if (p >= 0 ? distance < key.size() : distance <= key.size()) {
+      auto const c = key[p >= 0 ? distance : key.size() - distance];
+      signature |= (static_cast<std::uint64_t>(c) & 0xFF) << (8 * i);
+    }
+  }
+  return signature;
+}
+
+// Number of distinct signatures among the N keys, counted in an open
+// addressing set of at least 2N slots.
+template <class CharT, std::size_t N, class Keys>
+constexpr std::size_t count_distinct_signatures(Keys const &keys, std::ptrdiff_t const *positions,
+                                                std::size_t count) {
+  constexpr std::size_t slots = next_highest_power_of_two(2 * N);
+  constexpr std::uint64_t used = std::uint64_t(1) << 63;
+  carray<std::uint64_t, slots> set;
+  std::size_t distinct = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    std::uint64_t const signature = position_signature<CharT>(keys[i], positions, count) | used;
+    std::size_t slot = elsa<std::uint64_t>{}(signature, 0) & (slots - 1);
+    while (set[slot] && set[slot] != signature)
+      slot = (slot + 1) & (slots - 1);
+    if (!set[slot]) {
+      set[slot] = signature;
+      ++distinct;
+    }
+  }
+  return distinct;
+}
+
+} // namespace bits
+
+// gperf-style string hash: hashes the length of a key plus a few of its
+// characters only, at positions selected by make_position_hash so that they
+// tell all the keys of a given set apart. Without positions, hashes every
+// character, as elsa does.
+template <class CharT>
+class basic_position_hash {
+  std::ptrdiff_t positions_[bits::position_hash_positions] = {};
+  std::size_t count_ = all_characters;
+
+public:
+  static constexpr std::size_t all_characters = static_cast<std::size_t>(-1);
+
+  constexpr basic_position_hash() = default;
+  constexpr basic_position_hash(std::ptrdiff_t const *positions, std::size_t count) : count_(count) {
+    for (std::size_t i = 0; i < count; ++i)
+      positions_[i] = positions[i];
+  }
+
+  // Number of hashed positions, or all_characters.
+  constexpr std::size_t position_count() const { return count_; }
+  constexpr std::ptrdiff_t position(std::size_t i) const { return positions_[i]; }
+
+  constexpr std::size_t operator()(basic_string<CharT> key, std::size_t seed) const {
+    if (count_ == all_characters)
+      return elsa<basic_string<CharT>>{}(key, seed);
+    return elsa<std::uint64_t>{}(bits::position_signature(key, positions_, count_), seed);
+  }
+};
+
+using position_hash = basic_position_hash<char>;
+
+namespace bits {
+
+// Greedy search: adds the position that tells the most keys apart, until all
+// are or position_hash_positions are used, in which case the hash falls back
+// to all the characters. Each round hashes the N keys 2 * window times: meant
+// for keyword sets, large sets may hit the compiler constexpr step limit.
+template <class CharT, std::size_t N, class Keys>
+constexpr basic_position_hash<CharT> select_positions(Keys const &keys) {
+  std::size_t longest = 0;
+  for (std::size_t i = 0; i < N; ++i)
+    longest = keys[i].size() > longest ? keys[i].size() : longest;
+  std::ptrdiff_t const window = static_cast<std::ptrdiff_t>(longest) < position_hash_window
+                                    ? static_cast<std::ptrdiff_t>(longest)
+                                    : position_hash_window;
+
+  std::ptrdiff_t positions[position_hash_positions] = {};
+  std::size_t count = 0;
+  std::size_t distinct = count_distinct_signatures<CharT, N>(keys, positions, 0);
+  while (distinct < N && count < position_hash_positions) {
+    std::size_t best = distinct;
+    for (std::ptrdiff_t candidate = -window; candidate < window; ++candidate) {
+      bool chosen = false;
+      for (std::size_t i = 0; i < count; ++i)
+        chosen = chosen || positions[i] == candidate;
+      if (chosen)
+        continue;
+      std::ptrdiff_t const previous = positions[count];
+      positions[count] = candidate;
+      std::size_t const separated = count_distinct_signatures<CharT, N>(keys, positions, count + 1);
+      if (separated <= best)
+        positions[count] = previous;
+      else
+        best = separated;
+    }
+    if (best == distinct)
+      break;
+    distinct = best;
+    ++count;
+  }
+  if (distinct < N)
+    return {};
+  return {positions, count};
+}
+
+template <class Item> struct position_keys {
+  Item const *items;
+  constexpr auto const &operator[](std::size_t i) const { return items[i].first; }
+};
+
+} // namespace bits
+
+// Position hash for the keys of `items`.
+template <class CharT, class Value, std::size_t N>
+constexpr basic_position_hash<CharT> make_position_hash(std::pair<basic_string<CharT>, Value> const (&items)[N]) {
+  return bits::select_positions<CharT, N>(bits::position_keys<std::pair<basic_string<CharT>, Value>>{items});
+}
+template <class CharT, std::size_t N>
+constexpr basic_position_hash<CharT> make_position_hash(basic_string<CharT> const (&keys)[N]) {
+  return bits::select_positions<CharT, N>(keys);
+}
+
+// unordered_map and unordered_set hashed by make_position_hash.
+template <class CharT, class Value, std::size_t N>
+constexpr auto make_positional_unordered_map(std::pair<basic_string<CharT>, Value> const (&items)[N]) {
+  return unordered_map<basic_string<CharT>, Value, N, basic_position_hash<CharT>>{
+      items, make_position_hash(items), std::equal_to<basic_string<CharT>>{}};
+}
+template <class CharT, std::size_t N>
+constexpr auto make_positional_unordered_set(basic_string<CharT> const (&keys)[N]) {
+  return unordered_set<basic_string<CharT>, N, basic_position_hash<CharT>>{
+      keys, make_position_hash(keys), std::equal_to<basic_string<CharT>>{}};
+}
+
+} // namespace frozen
+
+#endif
@@ -100,6 +100,12 @@ public:
     return this->find(key) != keys_.end();
   }
 
+  // Index of the given key, size() if there is none.
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &key) const {
+    return static_cast<std::size_t>(find(key) - begin());
+  }
+
   template <class KeyType>
   constexpr std::pair<const_iterator, const_iterator> equal_range(KeyType const &key) const {
     auto const lower = lower_bound(key);
@@ -195,6 +201,9 @@ public:
   template <class KeyType>
   constexpr const_iterator find(KeyType const &) const { return end(); }
 
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &) const { return 0; }
+
   template <class KeyType>
   constexpr std::pair<const_iterator, const_iterator>
   equal_range(KeyType const &) const { return {end(), end()}; }
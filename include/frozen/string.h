@@ -25,10 +25,12 @@
 
 #include "frozen/bits/elsa.h"
 #include "frozen/bits/hash_string.h"
+#include "frozen/bits/string_compare.h"
 #include "frozen/bits/version.h"
 #include "frozen/bits/defines.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 
 #ifdef FROZEN_LETITGO_HAS_STRING_VIEW
@@ -71,6 +73,10 @@ public:
   constexpr bool operator==(basic_string other) const {
     if (size_ != other.size_)
       return false;
+#ifdef FROZEN_LETITGO_HAS_IS_CONSTANT_EVALUATED
+    if (!__builtin_is_constant_evaluated() && size_ >= bits::str_block_size)
+      return bits::str_equal(data_, other.data_, size_);
+#endif
     for (std::size_t i = 0; i < size_; ++i)
       if (data_[i] != other.data_[i])
         return false;
@@ -78,7 +84,17 @@ public:
   }
 
   constexpr bool operator<(const basic_string &other) const {
-    unsigned i = 0;
+#ifdef FROZEN_LETITGO_HAS_IS_CONSTANT_EVALUATED
+    // Only worth it for long strings, short ones mostly differ early.
+    // Characters are still compared as chr_t, as below, so that runtime
+    // lookups agree with the order of keys sorted at compile time.
+    std::size_t const common = size_ < other.size_ ? size_ : other.size_;
+    if (!__builtin_is_constant_evaluated() && common >= bits::str_block_size) {
+      std::size_t const i = bits::str_mismatch(data_, other.data_, common);
+      return i < common ? data_[i] < other.data_[i] : size_ < other.size_;
+    }
+#endif
+    std::size_t i = 0;
     while (i < size() && i < other.size()) {
       if ((*this)[i] < other[i]) {
         return true;
@@ -115,6 +131,48 @@ template <typename _CharT> struct elsa<basic_string<_CharT>> {
   }
 };
 
+// Incremental 64-bit FNV-1a hash of a string, fed one character or one
+// chunk at a time, e.g. while a lexer scans a token. finish() is the base
+// hash of incremental_elsa, to pass to find_hashed.
+template <typename _CharT> class basic_string_hash_state {
+  std::uint64_t d_ = 0xcbf29ce484222325ull;
+
+public:
+  constexpr basic_string_hash_state &update(_CharT c) {
+    d_ = (d_ ^ static_cast<std::uint64_t>(c)) * 0x100000001b3ull;
+    return *this;
+  }
+  constexpr basic_string_hash_state &update(_CharT const *data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i)
+      update(data[i]);
+    return *this;
+  }
+  constexpr basic_string_hash_state &update(basic_string<_CharT> data) {
+    return update(data.data(), data.size());
+  }
+  constexpr std::uint64_t finish() const { return d_; }
+};
+
+// Seeded string hash built on a seed-independent base hash, so that a key
+// hashed once, for instance with a basic_string_hash_state, can be looked up
+// with find_hashed: all the seeds of the perfect hash tables are mixed in
+// afterwards, by combine.
+template <class Key> struct incremental_elsa;
+
+template <typename _CharT> struct incremental_elsa<basic_string<_CharT>> {
+  using state_type = basic_string_hash_state<_CharT>;
+
+  constexpr std::uint64_t base(basic_string<_CharT> value) const {
+    return state_type{}.update(value).finish();
+  }
+  constexpr std::size_t combine(std::uint64_t base_hash, std::size_t seed) const {
+    return elsa<std::uint64_t>{}(base_hash, seed);
+  }
+  constexpr std::size_t operator()(basic_string<_CharT> value, std::size_t seed) const {
+    return combine(base(value), seed);
+  }
+};
+
 using string = basic_string<char>;
 using wstring = basic_string<wchar_t>;
 using u16string = basic_string<char16_t>;
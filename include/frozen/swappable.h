@@ -0,0 +1,178 @@
+/*
+ * Frozen
+ * Copyright 2016 QuarksLab
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef FROZEN_LETITGO_SWAPPABLE_H
+#define FROZEN_LETITGO_SWAPPABLE_H
+
+#include "frozen/bits/exceptions.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+namespace bits {
+
+// Per reader state of swappable, alone on its cache line: readers only ever
+// write to their own slot.
+struct reader_slot {
+  static constexpr std::size_t stride = 128; // two cache lines, whatever the allocation alignment
+
+  std::atomic<std::uint64_t> epoch{0}; // 0 when not reading
+  std::atomic<bool> claimed{false};
+  char padding[stride - sizeof(std::atomic<std::uint64_t>) - sizeof(std::atomic<bool>)];
+};
+
+} // namespace bits
+
+// Holds a read-only Table that a writer can replace while readers keep on
+// looking it up, in the spirit of RCU.
+//
+// Each reader thread owns a `reader`, obtained once from `make_reader()`.
+// `reader::read()` returns a snapshot of the current table, valid until the
+// snapshot is destroyed. Taking a snapshot announces the current epoch in the
+// reader's own slot: a plain store followed by a fence, no read-modify-write
+// on shared data.
+//
+// `publish()` installs a new table, then waits for the snapshots of the
+// previous one to go away before destroying it. Writers are serialized.
+template <class Table>
+class swappable {
+  std::atomic<Table const *> current_;
+  std::atomic<std::uint64_t> epoch_{1};
+  std::unique_ptr<bits::reader_slot[]> slots_;
+  std::size_t slot_count_;
+  std::mutex writer_;
+
+public:
+  class reader;
+
+  // A table being read. Snapshots of a reader must not overlap.
+  class snapshot {
+    Table const *table_;
+    bits::reader_slot *slot_;
+
+    friend class reader;
+    snapshot(Table const *table, bits::reader_slot *slot) : table_(table), slot_(slot) {}
+
+  public:
+    snapshot(snapshot &&other) noexcept : table_(other.table_), slot_(other.slot_) { other.slot_ = nullptr; }
+    snapshot(snapshot const &) = delete;
+    snapshot &operator=(snapshot const &) = delete;
+    snapshot &operator=(snapshot &&) = delete;
+    ~snapshot() {
+      if (slot_)
+        slot_->epoch.store(0, std::memory_order_release);
+    }
+
+    Table const &operator*() const { return *table_; }
+    Table const *operator->() const { return table_; }
+    Table const *get() const { return table_; }
+  };
+
+  // Registration of a reader thread, bound to one slot of the swappable.
+  class reader {
+    swappable const *owner_;
+    bits::reader_slot *slot_;
+
+    friend class swappable;
+    reader(swappable const *owner, bits::reader_slot *slot) : owner_(owner), slot_(slot) {}
+
+  public:
+    reader(reader &&other) noexcept : owner_(other.owner_), slot_(other.slot_) { other.slot_ = nullptr; }
+    reader(reader const &) = delete;
+    reader &operator=(reader const &) = delete;
+    reader &operator=(reader &&) = delete;
+    ~reader() {
+      if (slot_)
+        slot_->claimed.store(false, std::memory_order_release);
+    }
+
+    snapshot read() const {
+      // Announce the epoch before loading the table: the writer either sees
+      // the announcement, or published its table before the load.
+      slot_->epoch.store(owner_->epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return {owner_->current_.load(std::memory_order_acquire), slot_};
+    }
+  };
+
+  explicit swappable(std::unique_ptr<Table const> table, std::size_t max_readers = 64)
+      : current_(table.release())
+      , slots_(new bits::reader_slot[max_readers])
+      , slot_count_(max_readers) {}
+
+  swappable(swappable const &) = delete;
+  swappable &operator=(swappable const &) = delete;
+
+  // No reader may be left.
+  ~swappable() { delete current_.load(std::memory_order_relaxed); }
+
+  std::size_t max_readers() const { return slot_count_; }
+
+  // Claims a reader slot, throws std::length_error if all are taken.
+  reader make_reader() {
+    for (std::size_t i = 0; i < slot_count_; ++i) {
+      bool expected = false;
+      if (slots_[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        return {this, &slots_[i]};
+    }
+    FROZEN_THROW_OR_ABORT(std::length_error("too many swappable readers"));
+  }
+
+  // Current table, for the writer side. Not protected from a concurrent
+  // publish().
+  Table const &unsafe_get() const { return *current_.load(std::memory_order_acquire); }
+
+  // Replaces the table, and returns the previous one once no reader can see
+  // it anymore.
+  std::unique_ptr<Table const> exchange(std::unique_ptr<Table const> table) {
+    std::lock_guard<std::mutex> lock(writer_);
+    Table const *const previous = current_.exchange(table.release(), std::memory_order_seq_cst);
+    std::uint64_t const epoch = epoch_.load(std::memory_order_relaxed) + 1;
+    epoch_.store(epoch, std::memory_order_seq_cst);
+
+    // Grace period: wait for the readers that announced an older epoch.
+    for (std::size_t i = 0; i < slot_count_; ++i) {
+      for (;;) {
+        std::uint64_t const seen = slots_[i].epoch.load(std::memory_order_seq_cst);
+        if (seen == 0 || seen >= epoch)
+          break;
+        std::this_thread::yield();
+      }
+    }
+    return std::unique_ptr<Table const>(previous);
+  }
+
+  // Replaces the table and reclaims the previous one.
+  void publish(std::unique_ptr<Table const> table) { exchange(std::move(table)); }
+};
+
+} // namespace frozen
+
+#endif
@@ -24,12 +24,14 @@
 #define FROZEN_LETITGO_UNORDERED_MAP_H
 
 #include "frozen/bits/basic_types.h"
+#include "frozen/bits/constexpr_assert.h"
 #include "frozen/bits/elsa.h"
 #include "frozen/bits/exceptions.h"
 #include "frozen/bits/pmh.h"
 #include "frozen/bits/version.h"
 #include "frozen/random.h"
 
+#include <cstdint>
 #include <tuple>
 #include <functional>
 #include <utility>
@@ -49,14 +51,15 @@ struct GetKey {
 template <class Key, class Value, std::size_t N, typename Hash = anna<Key>,
           class KeyEqual = std::equal_to<Key>>
 class unordered_map : private KeyEqual {
-  static constexpr std::size_t storage_size =
-      bits::next_highest_power_of_two(N) * (N < 32 ? 2 : 1); // size adjustment to prevent high collision rate for small sets
+  static constexpr std::size_t storage_size = bits::pmh_storage_size(N);
   using container_type = bits::carray<std::pair<const Key, Value>, N>;
-  using tables_type = bits::pmh_tables<storage_size, Hash>;
+  using tables_type = bits::pmh_tables_for<storage_size, Key, Hash>;
 
   container_type items_;
   tables_type tables_;
 
+  friend struct bits::pmh_access;
+
 public:
   /* typedefs */
   using Self = unordered_map<Key, Value, N, Hash, KeyEqual>;
@@ -82,7 +85,7 @@ public:
       : KeyEqual{equal}
       , items_{items}
       , tables_{
-            bits::make_pmh_tables<storage_size>(
+            bits::make_tables(bits::tables_tag<tables_type>{},
                 items_, hash, equal, bits::GetKey{}, default_prg_t{})} {}
   explicit constexpr unordered_map(container_type items)
       : unordered_map{items, Hash{}, KeyEqual{}} {
@@ -133,11 +136,47 @@ public:
     return find_impl(*this, key, hash_function(), key_eq());
   }
 
+  // Same as find, for a key whose base hash was already computed, e.g. by an
+  // incremental_elsa state_type: the key is not hashed again.
+  template <class KeyType>
+  constexpr const_iterator find_hashed(KeyType const &key, std::uint64_t hash) const {
+    return find_impl(*this, key, bits::prehashed<Hash>{hash_function(), hash}, key_eq());
+  }
+  template <class KeyType>
+  constexpr iterator find_hashed(KeyType const &key, std::uint64_t hash) {
+    return find_impl(*this, key, bits::prehashed<Hash>{hash_function(), hash}, key_eq());
+  }
+
+  // Same as find, for a key known to be in the map, e.g. an enumerator when
+  // the map holds them all: the key is not compared to the item found, which
+  // is only checked in debug builds. Other keys give an unspecified index,
+  // possibly size().
+  template <class KeyType>
+  constexpr std::size_t index_unchecked(KeyType const &key) const {
+    auto const pos = tables_.lookup(key, hash_function());
+    FROZEN_LETITGO_DEBUG_ASSERT(pos < N && key_eq()(items_[pos].first, key), "key must be in the map");
+    return pos;
+  }
+  template <class KeyType>
+  constexpr const_iterator find_unchecked(KeyType const &key) const {
+    return begin() + index_unchecked(key);
+  }
+  template <class KeyType>
+  constexpr iterator find_unchecked(KeyType const &key) {
+    return begin() + index_unchecked(key);
+  }
+
   template <class KeyType>
   constexpr bool contains(KeyType const &key) const {
     return this->find(key) != this->end();
   }
 
+  // Index of the item with the given key, size() if there is none.
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &key) const {
+    return static_cast<std::size_t>(find(key) - begin());
+  }
+
   template <class KeyType>
   constexpr std::pair<const_iterator, const_iterator> equal_range(KeyType const &key) const {
     return equal_range_impl(*this, key);
@@ -24,11 +24,13 @@
 #define FROZEN_LETITGO_UNORDERED_SET_H
 
 #include "frozen/bits/basic_types.h"
+#include "frozen/bits/constexpr_assert.h"
 #include "frozen/bits/elsa.h"
 #include "frozen/bits/pmh.h"
 #include "frozen/bits/version.h"
 #include "frozen/random.h"
 
+#include <cstdint>
 #include <utility>
 
 namespace frozen {
@@ -46,14 +48,15 @@ struct Get {
 template <class Key, std::size_t N, typename Hash = elsa<Key>,
           class KeyEqual = std::equal_to<Key>>
 class unordered_set : private KeyEqual {
-  static constexpr std::size_t storage_size =
-      bits::next_highest_power_of_two(N) * (N < 32 ? 2 : 1); // size adjustment to prevent high collision rate for small sets
+  static constexpr std::size_t storage_size = bits::pmh_storage_size(N);
   using container_type = bits::carray<Key, N>;
-  using tables_type = bits::pmh_tables<storage_size, Hash>;
+  using tables_type = bits::pmh_tables_for<storage_size, Key, Hash>;
 
   container_type keys_;
   tables_type tables_;
 
+  friend struct bits::pmh_access;
+
 public:
   /* typedefs */
   using key_type = Key;
@@ -76,7 +79,7 @@ public:
                           KeyEqual const &equal)
       : KeyEqual{equal}
       , keys_{keys}
-      , tables_{bits::make_pmh_tables<storage_size>(
+      , tables_{bits::make_tables(bits::tables_tag<tables_type>{},
             keys_, hash, equal, bits::Get{}, default_prg_t{})} {}
   explicit constexpr unordered_set(container_type keys)
       : unordered_set{keys, Hash{}, KeyEqual{}} {}
@@ -124,11 +127,38 @@ public:
       return keys_.end();
   }
 
+  // Same as find, for a key whose base hash was already computed, e.g. by an
+  // incremental_elsa state_type: the key is not hashed again.
+  template <class KeyType>
+  constexpr const_iterator find_hashed(KeyType const &key, std::uint64_t hash) const {
+    return find(key, bits::prehashed<Hash>{hash_function(), hash}, key_eq());
+  }
+
+  // Same as find, for a key known to be in the set: the key is not compared
+  // to the one found, which is only checked in debug builds. Other keys give
+  // an unspecified index, possibly size().
+  template <class KeyType>
+  constexpr std::size_t index_unchecked(KeyType const &key) const {
+    auto const pos = tables_.lookup(key, hash_function());
+    FROZEN_LETITGO_DEBUG_ASSERT(pos < N && key_eq()(keys_[pos], key), "key must be in the set");
+    return pos;
+  }
+  template <class KeyType>
+  constexpr const_iterator find_unchecked(KeyType const &key) const {
+    return begin() + index_unchecked(key);
+  }
+
   template <class KeyType>
   constexpr bool contains(KeyType const &key) const {
     return this->find(key) != keys_.end();
   }
 
+  // Index of the given key, size() if there is none.
+  template <class KeyType>
+  constexpr std::size_t index_of(KeyType const &key) const {
+    return static_cast<std::size_t>(find(key) - begin());
+  }
+
   template <class KeyType>
   constexpr std::pair<const_iterator, const_iterator> equal_range(KeyType const &key) const {
     auto const it = find(key);
@@ -0,0 +1,19 @@
+# Compares the relative relocations of the PLAIN and PACKED shared objects
+# built from relocations.cpp: packing the KEYS keys must remove at least one
+# relocation per key.
+foreach(object PLAIN PACKED)
+  execute_process(COMMAND ${READELF} -rW ${${object}}
+                  OUTPUT_VARIABLE relocations
+                  RESULT_VARIABLE status)
+  if(NOT status EQUAL 0)
+    message(FATAL_ERROR "${READELF} failed on ${${object}}")
+  endif()
+  string(REGEX MATCHALL "_RELATIVE" relocations "${relocations}")
+  list(LENGTH relocations ${object}_COUNT)
+endforeach()
+
+message(STATUS "relative relocations: ${PLAIN_COUNT} with plain keys, ${PACKED_COUNT} with packed keys")
+math(EXPR removed "${PLAIN_COUNT} - ${PACKED_COUNT}")
+if(removed LESS KEYS)
+  message(FATAL_ERROR "packed keys removed ${removed} relocations, expected at least ${KEYS}")
+endif()
@@ -0,0 +1,172 @@
+#include <frozen/auto_hash.h>
+#include <frozen/hardware_hash.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+#include <frozen/unordered_set.h>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+static constexpr frozen::string c_keywords[] = {
+    "auto",     "break",  "case",    "char",   "const",    "continue",
+    "default",  "do",     "double",  "else",   "enum",     "extern",
+    "float",    "for",    "goto",    "if",     "int",      "long",
+    "register", "return", "short",   "signed", "sizeof",   "static",
+    "struct",   "switch", "typedef", "union",  "unsigned", "void",
+    "volatile", "while"};
+
+static constexpr std::pair<int, int> squares[] = {{1, 1}, {2, 4}, {3, 9}, {4, 16}, {5, 25}};
+static constexpr unsigned ports[] = {21, 22, 25, 53, 80, 110, 143, 443, 993, 995, 3306, 5432, 6379, 8080};
+
+using software_candidates = frozen::hash_candidates<frozen::elsa<frozen::string>,
+                                                    frozen::incremental_elsa<frozen::string>, frozen::position_hash>;
+
+TEST_CASE("auto hash choice", "[auto hash]") {
+  constexpr auto cheapest = frozen::make_auto_hash<software_candidates>(c_keywords);
+  // Three selected characters beat hashing every character.
+  static_assert(cheapest.family() == 2, "");
+  static_assert(cheapest.get<2>().position_count() != frozen::position_hash::all_characters, "");
+  static_assert(cheapest.statistics().cost < cheapest.statistics(0).cost, "");
+  static_assert(cheapest.statistics(0).cost < cheapest.statistics(1).cost, "");
+
+  constexpr auto fewest = frozen::make_auto_hash(c_keywords, frozen::hash_choice::fewest_seeds);
+  for (std::size_t family = 0; family < 5; ++family) {
+    REQUIRE(fewest.statistics(family).first_seeds >= 1);
+    REQUIRE(fewest.statistics(family).largest_bucket >= 1);
+    REQUIRE(fewest.statistics().seeds() <= fewest.statistics(family).seeds());
+  }
+
+  // A single candidate is always picked.
+  constexpr auto ints = frozen::make_auto_hash<frozen::hash_candidates<frozen::elsa<int>>>(squares);
+  static_assert(ints.family() == 0, "");
+  static_assert(ints.statistics().cost == 5, "");
+}
+
+TEST_CASE("auto hash of the hardware families", "[auto hash]") {
+  // The keywords fit in a word: a CRC of it and one of the length, or an AES
+  // round and two to finish.
+  constexpr auto tuned = frozen::make_auto_hash(c_keywords);
+  static_assert(std::is_same<frozen::hash_candidate_t<decltype(tuned)::candidates, 3>,
+                             frozen::crc_hash<frozen::string>>::value, "");
+  static_assert(std::is_same<frozen::hash_candidate_t<decltype(tuned)::candidates, 4>,
+                             frozen::aes_hash<frozen::string>>::value, "");
+  static_assert(tuned.statistics(3).cost == 2 * 32, "");
+  static_assert(tuned.statistics(4).cost == 3 * 32, "");
+  static_assert(tuned.family() == 3, "");
+  for (std::size_t family = 3; family < 5; ++family) {
+    REQUIRE(tuned.statistics(family).tried);
+    REQUIRE(tuned.statistics(family).first_seeds >= 1);
+    REQUIRE(tuned.statistics(family).largest_bucket >= 1);
+  }
+
+  constexpr auto ints = frozen::make_auto_hash(ports);
+  static_assert(ints.statistics(1).cost == 14 && ints.statistics(2).cost == 14, "");
+
+  constexpr frozen::string long_keys[] = {"a key of thirty-three characters.", "short"};
+  constexpr auto long_tuned = frozen::make_auto_hash(long_keys);
+  static_assert(long_tuned.statistics(3).cost == (5 + 1) + (1 + 1), "");
+  static_assert(long_tuned.statistics(4).cost == (3 + 2) + (1 + 2), "");
+}
+
+TEST_CASE("auto hash containers", "[auto hash]") {
+  constexpr auto keywords = frozen::make_auto_unordered_set(c_keywords);
+  static_assert(keywords.count("volatile"), "");
+  static_assert(!keywords.count("volatil"), "");
+  static_assert(keywords.hash_function().family() == 3, "");
+  for (auto keyword : c_keywords) {
+    std::string const copy(keyword.data(), keyword.size());
+    REQUIRE(keywords.count(frozen::string(copy.data(), copy.size())) == 1);
+  }
+  REQUIRE(keywords.count("cxntinue") == 0);
+
+  using candidates = frozen::hash_candidates<frozen::elsa<frozen::string>>;
+  constexpr auto single = frozen::make_auto_unordered_set<candidates>(c_keywords);
+  static_assert(single.hash_function().family() == 0, "");
+  static_assert(single.count("while"), "");
+
+  constexpr auto map = frozen::make_auto_unordered_map(squares);
+  static_assert(map.at(4) == 16, "");
+  REQUIRE(map.find(6) == map.end());
+}
+
+TEST_CASE("auto hash of integer keys", "[auto hash]") {
+  using frozen::bits::pmh_access;
+
+  constexpr auto tuned = frozen::make_auto_hash(ports);
+  static_assert(std::is_same<decltype(tuned)::candidates,
+                             frozen::hash_candidates<frozen::elsa<unsigned>, frozen::crc_hash<unsigned>,
+                                                     frozen::aes_hash<unsigned>>>::value,
+                "");
+  for (std::size_t family = 0; family < 3; ++family) {
+    REQUIRE(tuned.statistics(family).tried);
+    REQUIRE(tuned.statistics(family).first_seeds >= 1);
+  }
+
+  // Single level tables when elsa is picked, as with the default hasher.
+  constexpr auto ports_set = frozen::make_auto_unordered_set(ports);
+  static_assert(ports_set.count(443) && !ports_set.count(444), "");
+  static_assert((pmh_access::tables(ports_set).multiplier_ != 0) == (ports_set.hash_function().family() == 0), "");
+  for (auto port : ports)
+    REQUIRE(ports_set.count(port) == 1);
+  REQUIRE(ports_set.count(8081) == 0);
+
+  constexpr auto elsa_set = frozen::make_auto_unordered_set<frozen::hash_candidates<frozen::elsa<unsigned>>>(ports);
+  static_assert(pmh_access::tables(elsa_set).multiplier_ != 0, "");
+  static_assert(elsa_set.count(6379) && !elsa_set.count(6380), "");
+
+  using crc_candidates = frozen::hash_candidates<frozen::crc_hash<unsigned>, frozen::aes_hash<unsigned>>;
+  constexpr auto crc_set = frozen::make_auto_unordered_set<crc_candidates>(ports);
+  static_assert(std::is_same<std::remove_cv_t<std::remove_reference_t<decltype(pmh_access::tables(crc_set))>>,
+                             frozen::bits::pmh_tables<32, frozen::auto_hash<crc_candidates>>>::value,
+                "");
+  for (auto port : ports)
+    REQUIRE(crc_set.count(port) == 1);
+  REQUIRE(crc_set.count(8081) == 0);
+}
+
+TEST_CASE("auto hash choice in the type", "[auto hash]") {
+  static constexpr auto tuned = frozen::make_auto_hash<software_candidates>(c_keywords);
+  using hasher = frozen::hash_candidate_t<decltype(tuned)::candidates, tuned.family()>;
+  static_assert(std::is_same<hasher, frozen::position_hash>::value, "");
+
+  constexpr frozen::unordered_set<frozen::string, 32, hasher> keywords{c_keywords, tuned.get<tuned.family()>(),
+                                                                       std::equal_to<frozen::string>{}};
+  static_assert(keywords.count("typedef"), "");
+  REQUIRE(keywords.count("typedeff") == 0);
+}
+
+namespace {
+struct small_sets_hash : frozen::elsa<frozen::string> {};
+
+template <std::size_t... Is>
+void check_large_auto_hash(std::vector<std::string> const &names, std::index_sequence<Is...>) {
+  frozen::string const keys[] = {frozen::string(names[Is].data(), names[Is].size())...};
+  auto const large = frozen::make_auto_hash(keys);
+  REQUIRE(large.statistics(0).tried);
+  REQUIRE(!large.statistics(2).tried);
+  REQUIRE(large.family() != 2);
+}
+} // namespace
+
+template <> struct frozen::hash_candidate<small_sets_hash> : frozen::hash_candidate<frozen::elsa<frozen::string>> {
+  static constexpr std::size_t max_keys = 8;
+  template <std::size_t N, class Keys> static constexpr small_sets_hash make(Keys const &) { return {}; }
+};
+
+TEST_CASE("auto hash skips families past their max_keys", "[auto hash]") {
+  using candidates = frozen::hash_candidates<small_sets_hash, frozen::elsa<frozen::string>>;
+  constexpr auto tuned = frozen::make_auto_hash<candidates>(c_keywords);
+  static_assert(!tuned.statistics(0).tried, "");
+  static_assert(tuned.statistics(1).tried, "");
+  static_assert(tuned.family() == 1, "");
+
+  // The position search of the default candidates is not run on large sets.
+  std::vector<std::string> names;
+  for (int i = 0; i < 300; ++i)
+    names.push_back("entity_" + std::to_string(i * 7919));
+  check_large_auto_hash(names, std::make_index_sequence<300>{});
+}
@@ -0,0 +1,90 @@
+#include <frozen/bulk_lookup.h>
+#include <frozen/dynamic_unordered_map.h>
+#include <frozen/dynamic_unordered_set.h>
+#include <frozen/map.h>
+#include <frozen/set.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+#include <frozen/unordered_set.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+TEST_CASE("bulk lookup in constexpr containers", "[bulk lookup]") {
+  constexpr frozen::map<int, int, 4> ordered = {{1, 10}, {2, 20}, {3, 30}, {5, 50}};
+  constexpr frozen::unordered_map<int, int, 4> unordered = {{1, 10}, {2, 20}, {3, 30}, {5, 50}};
+  constexpr frozen::set<frozen::string, 2> ordered_set = {"Anna", "Elsa"};
+  constexpr frozen::unordered_set<frozen::string, 2> unordered_set = {"Anna", "Elsa"};
+
+  std::vector<int> const keys = {5, 4, 1, 0, 3, 2, 5};
+  std::vector<int> const expected = {50, 0, 10, 0, 30, 20, 50};
+  std::vector<char> const expected_found = {1, 0, 1, 0, 1, 1, 1};
+
+  std::vector<int> values(keys.size(), -1);
+  std::vector<char> found(keys.size(), -1);
+  frozen::bulk_lookup(ordered, keys.begin(), keys.end(), values.begin(), found.begin());
+  REQUIRE(values == expected);
+  REQUIRE(found == expected_found);
+
+  values.assign(keys.size(), -1);
+  found.assign(keys.size(), -1);
+  frozen::bulk_lookup(unordered, keys.begin(), keys.end(), values.begin(), found.begin());
+  REQUIRE(values == expected);
+  REQUIRE(found == expected_found);
+
+  std::vector<frozen::string> const names = {"Elsa", "Hans", "Anna"};
+  bool present[3] = {};
+  frozen::bulk_contains(ordered_set, names.begin(), names.end(), present);
+  REQUIRE((present[0] && !present[1] && present[2]));
+  bool unordered_present[3] = {};
+  frozen::bulk_contains(unordered_set, names.begin(), names.end(), unordered_present);
+  REQUIRE((unordered_present[0] && !unordered_present[1] && unordered_present[2]));
+
+  constexpr frozen::unordered_map<int, int, 4, frozen::branchless_hash<frozen::elsa<int>>> branchless = {
+      {1, 10}, {2, 20}, {3, 30}, {5, 50}};
+  values.assign(keys.size(), -1);
+  found.assign(keys.size(), -1);
+  frozen::bulk_lookup(branchless, keys.begin(), keys.end(), values.begin(), found.begin());
+  REQUIRE(values == expected);
+  REQUIRE(found == expected_found);
+}
+
+TEST_CASE("bulk lookup across threads", "[bulk lookup]") {
+  // Enough keys for several chunks and several shards.
+  std::vector<std::pair<unsigned, unsigned>> items;
+  for (unsigned i = 0; i < 20000; ++i)
+    items.emplace_back(i * 7, i);
+  frozen::dynamic_unordered_map<unsigned, unsigned> const table(items.begin(), items.end(),
+                                                                 frozen::parallel_build{});
+
+  std::vector<unsigned> keys;
+  for (unsigned i = 0; i < 100000; ++i)
+    keys.push_back(i * 3);
+
+  for (unsigned threads : {1u, 3u}) {
+    std::vector<unsigned> values(keys.size());
+    std::vector<unsigned char> found(keys.size());
+    frozen::bulk_lookup(table, keys.begin(), keys.end(), values.begin(), found.begin(), threads);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      bool const present = keys[i] % 7 == 0 && keys[i] / 7 < 20000;
+      REQUIRE(bool(found[i]) == present);
+      REQUIRE(values[i] == (present ? keys[i] / 7 : 0));
+    }
+  }
+
+  std::vector<std::string> words;
+  for (int i = 0; i < 5000; ++i)
+    words.push_back("word" + std::to_string(i));
+  words.push_back("missing");
+  std::vector<frozen::string> keys_of_words;
+  for (auto const &word : words)
+    keys_of_words.emplace_back(word.data(), word.size());
+  frozen::dynamic_unordered_set<frozen::string> const dictionary(keys_of_words.begin(), keys_of_words.end() - 1);
+  std::vector<char> found(words.size());
+  frozen::bulk_contains(dictionary, keys_of_words.begin(), keys_of_words.end(), found.begin(), 2);
+  REQUIRE(std::count(found.begin(), found.end(), 1) == 5000);
+  REQUIRE(found.back() == 0);
+}
@@ -0,0 +1,49 @@
+#include <frozen/column_table.h>
+#include <frozen/set.h>
+#include <frozen/string.h>
+
+#include <stdexcept>
+#include <tuple>
+
+#include "catch.hpp"
+
+TEST_CASE("column table", "[column table]") {
+  using person = std::tuple<frozen::string, int, double, frozen::string>;
+  static constexpr person rows[] = {
+      person{"Anna", 18, 1.62, "Arendelle"},
+      person{"Elsa", 21, 1.70, "North Mountain"},
+      person{"Olaf", 3, 1.04, "Arendelle"},
+      person{"Kristoff", 21, 1.86, "Valley of the Living Rock"},
+  };
+  constexpr auto table = frozen::make_column_table(rows);
+  static_assert(table.size() == 4 && table.column_count() == 3, "");
+  static_assert(table.at<0>("Olaf") == 3, "");
+  static_assert(table.at<2>("Elsa") == "North Mountain", "");
+
+  // Each column is its own array, at index_of of the keys.
+  auto const &ages = table.column<0>();
+  auto const &heights = table.column<1>();
+  for (auto const &row : rows) {
+    auto const index = table.index_of(std::get<0>(row));
+    REQUIRE(index < table.size());
+    REQUIRE(ages[index] == std::get<1>(row));
+    REQUIRE(heights[index] == std::get<2>(row));
+  }
+  REQUIRE(table.index_of("Hans") == table.size());
+  REQUIRE(!table.contains("Hans"));
+  REQUIRE_THROWS_AS(table.at<0>("Hans"), std::out_of_range);
+}
+
+TEST_CASE("column table on a set", "[column table]") {
+  // The columns follow the order of the keys in the set.
+  using table_type = frozen::basic_column_table<frozen::set<int, 3>, char, unsigned>;
+  constexpr table_type table = {{30, 'c', 3u}, {10, 'a', 1u}, {20, 'b', 2u}};
+  static_assert(table.column<0>()[0] == 'a' && table.column<0>()[2] == 'c', "");
+  static_assert(table.at<1>(20) == 2u, "");
+
+  frozen::column_table<int, 2, int> counts = {{5, 0}, {9, 0}};
+  ++counts.at<0>(9);
+  counts.column<0>()[counts.index_of(5)] += 2;
+  REQUIRE(counts.at<0>(5) == 2);
+  REQUIRE(counts.at<0>(9) == 1);
+}
@@ -0,0 +1,114 @@
+#include <frozen/bulk_lookup.h>
+#include <frozen/compact_unordered_map.h>
+#include <frozen/compact_unordered_set.h>
+#include <frozen/string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+TEST_CASE("empty frozen compact unordered map", "[compact unordered map]") {
+  std::vector<std::pair<int, int>> const none;
+  frozen::compact_unordered_map<int, int> const ze_map(none.begin(), none.end());
+
+  REQUIRE(ze_map.empty());
+  REQUIRE(ze_map.size() == 0);
+  REQUIRE(ze_map.begin() == ze_map.end());
+  REQUIRE(ze_map.count(3) == 0);
+  REQUIRE(ze_map.find(3) == ze_map.end());
+  REQUIRE_THROWS_AS(ze_map.at(3), std::out_of_range);
+}
+
+TEST_CASE("frozen compact unordered map", "[compact unordered map]") {
+  frozen::compact_unordered_map<int, double> ze_map{{1, 2.}, {3, 4.}, {5, 6.}};
+
+  REQUIRE(!ze_map.empty());
+  REQUIRE(ze_map.size() == 3);
+  REQUIRE(ze_map.max_size() == 3);
+
+  REQUIRE(ze_map.count(3) == 1);
+  REQUIRE(ze_map.count(4) == 0);
+  REQUIRE(ze_map.contains(5));
+  REQUIRE(ze_map.at(1) == 2.);
+  REQUIRE_THROWS_AS(ze_map.at(2), std::out_of_range);
+  REQUIRE(ze_map.begin()[ze_map.index_of(3)].first == 3);
+  REQUIRE(ze_map.index_of(4) == ze_map.size());
+
+  auto range = ze_map.equal_range(3);
+  REQUIRE(std::distance(range.first, range.second) == 1);
+  REQUIRE(range.first->second == 4.);
+
+  ze_map.at(3) = 7.;
+  ze_map.find(5)->second = 8.;
+  REQUIRE(ze_map.at(3) == 7.);
+  REQUIRE(ze_map.at(5) == 8.);
+}
+
+TEST_CASE("large frozen compact unordered map", "[compact unordered map]") {
+  std::vector<std::pair<std::uint64_t, std::size_t>> items;
+  for (std::size_t i = 0; i < 200000; ++i)
+    items.emplace_back(i * 7919, i);
+
+  frozen::compact_unordered_map<std::uint64_t, std::size_t> const ze_map(items.begin(), items.end());
+  REQUIRE(ze_map.size() == items.size());
+
+  for (auto const &item : items) {
+    auto const where = ze_map.find(item.first);
+    REQUIRE(where != ze_map.end());
+    REQUIRE(where->second == item.second);
+  }
+  for (std::size_t i = 0; i < 200000; ++i)
+    REQUIRE(!ze_map.contains(i * 7919 + 1));
+
+  // The tables map the keys to [0, size()) in a few bits per key.
+  auto const &tables = frozen::bits::pmh_access::tables(ze_map);
+  REQUIRE(tables.size_in_bits() < 4 * items.size());
+}
+
+TEST_CASE("frozen compact unordered map rejects duplicate keys", "[compact unordered map]") {
+  std::vector<std::pair<int, int>> const items{{1, 1}, {2, 2}, {1, 3}};
+  REQUIRE_THROWS_AS((frozen::compact_unordered_map<int, int>(items.begin(), items.end())),
+                    std::invalid_argument);
+}
+
+TEST_CASE("frozen compact unordered set", "[compact unordered set]") {
+  std::vector<std::string> const names{"elsa", "anna", "olaf", "kristoff", "sven", "hans"};
+  std::vector<frozen::string> keys;
+  for (auto const &name : names)
+    keys.emplace_back(name.data(), name.size());
+
+  frozen::compact_unordered_set<frozen::string> const ze_set(keys.begin(), keys.end());
+  REQUIRE(ze_set.size() == names.size());
+
+  for (auto const &key : keys) {
+    REQUIRE(ze_set.count(key) == 1);
+    REQUIRE(*ze_set.find(key) == key);
+  }
+  REQUIRE(!ze_set.contains(frozen::string("marshmallow")));
+  REQUIRE(std::is_permutation(ze_set.begin(), ze_set.end(), keys.begin()));
+
+  auto range = ze_set.equal_range(frozen::string("olaf"));
+  REQUIRE(std::distance(range.first, range.second) == 1);
+  range = ze_set.equal_range(frozen::string("oaken"));
+  REQUIRE(range.first == ze_set.end());
+}
+
+TEST_CASE("frozen compact unordered set bulk_contains", "[compact unordered set]") {
+  std::vector<std::uint64_t> keys;
+  for (std::uint64_t i = 0; i < 5000; ++i)
+    keys.push_back(i * i + 1);
+  frozen::compact_unordered_set<std::uint64_t> const ze_set(keys.begin(), keys.end());
+
+  std::vector<std::uint64_t> queries;
+  for (std::uint64_t i = 0; i < 20000; ++i)
+    queries.push_back(i);
+  std::vector<char> found(queries.size());
+  frozen::bulk_contains(ze_set, queries.begin(), queries.end(), found.begin(), 2);
+  for (std::size_t i = 0; i < queries.size(); ++i)
+    REQUIRE(bool(found[i]) == ze_set.contains(queries[i]));
+}
@@ -0,0 +1,57 @@
+#include <frozen/counter_map.h>
+#include <frozen/string.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+TEST_CASE("counter map", "[counter map]") {
+  static frozen::counter_map<frozen::string, long, 3> hits{"/", "/login", "/logout"};
+
+  REQUIRE(hits.size() == 3);
+  REQUIRE(hits.count(frozen::string("/login")) == 1);
+  REQUIRE(hits.load(frozen::string("/login")) == 0);
+
+  REQUIRE(hits.add(frozen::string("/login")));
+  REQUIRE(hits.add(frozen::string("/login"), 4));
+  REQUIRE(!hits.add(frozen::string("/admin")));
+  REQUIRE(hits.load(frozen::string("/login")) == 5);
+  REQUIRE(hits.load(frozen::string("/")) == 0);
+  REQUIRE_THROWS_AS(hits.load(frozen::string("/admin")), std::out_of_range);
+
+  long total = 0;
+  hits.for_each([&](frozen::string, long value) { total += value; });
+  REQUIRE(total == 5);
+
+  hits.reset();
+  REQUIRE(hits.load(frozen::string("/login")) == 0);
+
+  // Each counter has its own cache line.
+  REQUIRE(sizeof(hits) >= 3 * frozen::bits::cache_line_size);
+}
+
+template <class Counters>
+static void count_concurrently(Counters &counters) {
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&counters] {
+      for (int i = 0; i < 10000; ++i)
+        counters.add(1 + i % 4);
+    });
+  for (auto &thread : threads)
+    thread.join();
+}
+
+TEST_CASE("counter map shared by several threads", "[counter map]") {
+  static frozen::counter_map<int, unsigned long, 4> padded{1, 2, 3, 4};
+  count_concurrently(padded);
+  for (int key = 1; key <= 4; ++key)
+    REQUIRE(padded.load(key) == 10000);
+
+  static frozen::counter_map<int, unsigned long, 4, 8> sharded{1, 2, 3, 4};
+  count_concurrently(sharded);
+  for (int key = 1; key <= 4; ++key)
+    REQUIRE(sharded.load(key) == 10000);
+}
@@ -0,0 +1,248 @@
+#include <frozen/dynamic_unordered_map.h>
+#include <frozen/dynamic_unordered_set.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+TEST_CASE("empty frozen dynamic unordered map", "[dynamic unordered map]") {
+  std::vector<std::pair<int, int>> const none;
+  frozen::dynamic_unordered_map<int, int> const ze_map(none.begin(), none.end());
+
+  REQUIRE(ze_map.empty());
+  REQUIRE(ze_map.size() == 0);
+  REQUIRE(ze_map.begin() == ze_map.end());
+  REQUIRE(ze_map.count(3) == 0);
+  REQUIRE(ze_map.find(3) == ze_map.end());
+  REQUIRE_THROWS_AS(ze_map.at(3), std::out_of_range);
+}
+
+TEST_CASE("frozen dynamic unordered map", "[dynamic unordered map]") {
+  frozen::dynamic_unordered_map<int, double> ze_map{{1, 2.}, {3, 4.}, {5, 6.}};
+
+  REQUIRE(!ze_map.empty());
+  REQUIRE(ze_map.size() == 3);
+  REQUIRE(ze_map.max_size() == 3);
+  REQUIRE(ze_map.bucket_count() == 8);
+
+  REQUIRE(ze_map.count(3) == 1);
+  REQUIRE(ze_map.count(4) == 0);
+  REQUIRE(ze_map.contains(5));
+  REQUIRE(ze_map.at(1) == 2.);
+  REQUIRE_THROWS_AS(ze_map.at(2), std::out_of_range);
+
+  auto range = ze_map.equal_range(3);
+  REQUIRE(std::distance(range.first, range.second) == 1);
+  REQUIRE(range.first->second == 4.);
+
+  ze_map.at(3) = 7.;
+  ze_map.find(5)->second = 8.;
+  REQUIRE(ze_map.at(3) == 7.);
+  REQUIRE(ze_map.at(5) == 8.);
+}
+
+TEST_CASE("frozen dynamic unordered map matches the constexpr one", "[dynamic unordered map]") {
+  constexpr frozen::unordered_map<frozen::string, int, 4> fixed{
+      {"Tenant-A", 1}, {"Tenant-B", 2}, {"Tenant-C", 3}, {"Tenant-D", 4}};
+  frozen::dynamic_unordered_map<frozen::string, int> const runtime(fixed.begin(), fixed.end());
+
+  for (auto const &item : fixed)
+    REQUIRE(runtime.at(item.first) == item.second);
+  REQUIRE(!runtime.contains(frozen::string("Tenant-E")));
+}
+
+TEST_CASE("large frozen dynamic unordered map", "[dynamic unordered map]") {
+  std::vector<std::pair<std::size_t, std::size_t>> items;
+  for (std::size_t i = 0; i < 20000; ++i)
+    items.emplace_back(i * 7919, i);
+
+  frozen::dynamic_unordered_map<std::size_t, std::size_t> const ze_map(items.begin(), items.end());
+  REQUIRE(ze_map.size() == items.size());
+  REQUIRE(ze_map.bucket_count() == 32768);
+
+  for (auto const &item : items) {
+    auto const where = ze_map.find(item.first);
+    REQUIRE(where != ze_map.end());
+    REQUIRE(where->second == item.second);
+  }
+  for (std::size_t i = 0; i < 20000; ++i)
+    REQUIRE(!ze_map.contains(i * 7919 + 1));
+}
+
+TEST_CASE("frozen dynamic unordered map rejects duplicate keys", "[dynamic unordered map]") {
+  std::vector<std::pair<int, int>> const items{{1, 1}, {2, 2}, {1, 3}};
+  REQUIRE_THROWS_AS((frozen::dynamic_unordered_map<int, int>(items.begin(), items.end())),
+                    std::invalid_argument);
+}
+
+TEST_CASE("frozen dynamic unordered set", "[dynamic unordered set]") {
+  std::vector<std::string> const names{"elsa", "anna", "olaf", "kristoff", "sven", "hans"};
+  std::vector<frozen::string> keys;
+  for (auto const &name : names)
+    keys.emplace_back(name.data(), name.size());
+
+  frozen::dynamic_unordered_set<frozen::string> const ze_set(keys.begin(), keys.end());
+  REQUIRE(ze_set.size() == names.size());
+
+  for (auto const &key : keys) {
+    REQUIRE(ze_set.count(key) == 1);
+    REQUIRE(*ze_set.find(key) == key);
+  }
+  REQUIRE(!ze_set.contains(frozen::string("marshmallow")));
+  REQUIRE(std::is_permutation(ze_set.begin(), ze_set.end(), keys.begin()));
+
+  auto range = ze_set.equal_range(frozen::string("olaf"));
+  REQUIRE(std::distance(range.first, range.second) == 1);
+  range = ze_set.equal_range(frozen::string("oaken"));
+  REQUIRE(range.first == ze_set.end());
+}
+
+TEST_CASE("frozen dynamic unordered map built on several threads", "[dynamic unordered map]") {
+  std::vector<std::pair<std::size_t, std::size_t>> items;
+  for (std::size_t i = 0; i < 100000; ++i)
+    items.emplace_back(i * 7919, i);
+
+  frozen::dynamic_unordered_map<std::size_t, std::size_t> const ze_map(
+      items.begin(), items.end(), frozen::parallel_build{4});
+  REQUIRE(ze_map.size() == items.size());
+
+  for (auto const &item : items)
+    REQUIRE(ze_map.at(item.first) == item.second);
+  for (std::size_t i = 0; i < 100000; ++i)
+    REQUIRE(!ze_map.contains(i * 7919 + 1));
+
+  frozen::dynamic_unordered_map<std::size_t, std::size_t> const serial_map(
+      items.begin(), items.end(), frozen::parallel_build{1});
+  REQUIRE(serial_map.bucket_count() == ze_map.bucket_count());
+  for (auto const &item : items)
+    REQUIRE(serial_map.at(item.first) == item.second);
+
+  items.emplace_back(7919 * 5000, 0);
+  REQUIRE_THROWS_AS((frozen::dynamic_unordered_map<std::size_t, std::size_t>(
+                        items.begin(), items.end(), frozen::parallel_build{4})),
+                    std::invalid_argument);
+}
+
+TEST_CASE("frozen dynamic unordered set built on several threads", "[dynamic unordered set]") {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < 50000; ++i)
+    names.push_back("tenant-" + std::to_string(i));
+  std::vector<frozen::string> keys;
+  for (auto const &name : names)
+    keys.emplace_back(name.data(), name.size());
+
+  frozen::dynamic_unordered_set<frozen::string> const ze_set(
+      keys.begin(), keys.end(), frozen::parallel_build{3});
+  for (auto const &key : keys)
+    REQUIRE(ze_set.contains(key));
+  REQUIRE(!ze_set.contains(frozen::string("tenant-50000")));
+
+  // Small sets are not split.
+  frozen::dynamic_unordered_set<frozen::string> const small_set(
+      keys.begin(), keys.begin() + 100, frozen::parallel_build{3});
+  REQUIRE(small_set.bucket_count() == 128);
+  REQUIRE(small_set.contains(keys[99]));
+  REQUIRE(!small_set.contains(keys[100]));
+}
+
+TEST_CASE("frozen dynamic unordered map rebuild", "[dynamic unordered map]") {
+  frozen::dynamic_unordered_map<int, int> const ze_map{{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+
+  std::vector<std::pair<int, int>> const changes{{2, 21}, {5, 50}, {4, 41}};
+  std::vector<int> const erased{1, 4, 7};
+  auto const rebuilt = ze_map.rebuild(changes.begin(), changes.end(), erased.begin(), erased.end());
+
+  REQUIRE(rebuilt.size() == 4);
+  REQUIRE(rebuilt.bucket_count() == ze_map.bucket_count());
+  REQUIRE(!rebuilt.contains(1));
+  REQUIRE(rebuilt.at(2) == 21);
+  REQUIRE(rebuilt.at(3) == 30);
+  REQUIRE(rebuilt.at(4) == 41);
+  REQUIRE(rebuilt.at(5) == 50);
+  REQUIRE(!rebuilt.contains(7));
+  REQUIRE(ze_map.at(1) == 10);
+
+  // More keys than slots, the tables are built again.
+  std::vector<std::pair<int, int>> more;
+  for (int i = 10; i < 30; ++i)
+    more.emplace_back(i, i);
+  auto const grown = rebuilt.rebuild(more.begin(), more.end());
+  REQUIRE(grown.size() == 24);
+  REQUIRE(grown.bucket_count() == 64);
+  for (int i = 10; i < 30; ++i)
+    REQUIRE(grown.at(i) == i);
+  REQUIRE(grown.at(5) == 50);
+
+  // Items past the erased ones move into their slots.
+  std::vector<std::pair<int, int>> const moved{{4, 42}, {5, 51}};
+  std::vector<int> const front{2, 3};
+  auto const compacted = rebuilt.rebuild(moved.begin(), moved.end(), front.begin(), front.end());
+  REQUIRE(compacted.size() == 2);
+  REQUIRE(compacted.at(4) == 42);
+  REQUIRE(compacted.at(5) == 51);
+  REQUIRE(!compacted.contains(2));
+  REQUIRE(!compacted.contains(3));
+
+  // A new key inserted twice is added once, with its last value.
+  std::vector<std::pair<int, int>> const twice{{8, 1}, {3, 31}, {8, 2}, {3, 32}};
+  auto const deduplicated = ze_map.rebuild(twice.begin(), twice.end());
+  REQUIRE(deduplicated.size() == 5);
+  REQUIRE(deduplicated.at(8) == 2);
+  REQUIRE(deduplicated.at(3) == 32);
+}
+
+TEST_CASE("frozen dynamic unordered map rebuild of a large table", "[dynamic unordered map]") {
+  std::vector<std::pair<std::size_t, std::size_t>> items;
+  for (std::size_t i = 0; i < 60000; ++i)
+    items.emplace_back(i * 7919, i);
+
+  for (auto build : {frozen::parallel_build{1}, frozen::parallel_build{2}}) {
+    frozen::dynamic_unordered_map<std::size_t, std::size_t> const ze_map(items.begin(), items.end(), build);
+
+    std::vector<std::pair<std::size_t, std::size_t>> changes;
+    std::vector<std::size_t> erased;
+    for (std::size_t i = 0; i < 100; ++i) {
+      changes.emplace_back(i * 7919 + 1, i);
+      erased.push_back(i * 7919 * 13);
+    }
+    auto const rebuilt = ze_map.rebuild(changes.begin(), changes.end(), erased.begin(), erased.end());
+    REQUIRE(rebuilt.size() == items.size());
+    REQUIRE(rebuilt.bucket_count() == ze_map.bucket_count());
+
+    for (auto const &item : items)
+      REQUIRE(rebuilt.contains(item.first) == (item.first % (7919 * 13) != 0 || item.first >= 100 * 7919 * 13));
+    for (auto const &item : changes)
+      REQUIRE(rebuilt.at(item.first) == item.second);
+  }
+}
+
+TEST_CASE("frozen dynamic unordered set rebuild", "[dynamic unordered set]") {
+  frozen::dynamic_unordered_set<int> const ze_set{1, 2, 3, 4, 5};
+  std::vector<int> const inserted{6, 2, 7};
+  std::vector<int> const erased{1, 2, 8};
+
+  auto const rebuilt = ze_set.rebuild(inserted.begin(), inserted.end(), erased.begin(), erased.end());
+  REQUIRE(rebuilt.size() == 6);
+  REQUIRE(rebuilt.bucket_count() == ze_set.bucket_count());
+  for (int key : {2, 3, 4, 5, 6, 7})
+    REQUIRE(rebuilt.contains(key));
+  REQUIRE(!rebuilt.contains(1));
+  REQUIRE(!rebuilt.contains(8));
+
+  std::vector<int> const twice{9, 6, 9};
+  auto const deduplicated = ze_set.rebuild(twice.begin(), twice.end());
+  REQUIRE(deduplicated.size() == 7);
+  REQUIRE(deduplicated.contains(9));
+}
+
+TEST_CASE("frozen dynamic unordered map index_of", "[dynamic unordered map]") {
+  frozen::dynamic_unordered_map<int, char> dynamic = {{7, 'a'}, {3, 'b'}, {11, 'c'}};
+  REQUIRE(dynamic.index_of(11) == static_cast<std::size_t>(dynamic.find(11) - dynamic.begin()));
+  REQUIRE(dynamic.index_of(8) == dynamic.size());
+}
@@ -0,0 +1,61 @@
+#include <frozen/fixed_string.h>
+#include <frozen/map.h>
+#include <frozen/set.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+#include <frozen/unordered_set.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "catch.hpp"
+
+TEST_CASE("fixed string", "[fixed string]") {
+  constexpr frozen::fixed_string<16> elsa = "Elsa";
+  static_assert(elsa.size() == 4, "");
+  static_assert(elsa[0] == 'E' && elsa[3] == 'a', "");
+  static_assert(elsa == frozen::fixed_string<16>("Elsa"), "");
+  static_assert(elsa != frozen::fixed_string<16>("Anna"), "");
+  static_assert(sizeof(elsa) == 2 * 8 + sizeof(std::size_t), "");
+
+  // Lexicographic, shorter first, characters compared as unsigned.
+  static_assert(frozen::fixed_string<16>("Anna") < elsa, "");
+  static_assert(frozen::fixed_string<16>("Els") < elsa, "");
+  static_assert(frozen::fixed_string<16>("Elsa and Anna") > elsa, "");
+  static_assert(frozen::fixed_string<16>("Elsa") <= elsa, "");
+  static_assert(frozen::fixed_string<16>("\x80") > frozen::fixed_string<16>("z"), "");
+  static_assert(frozen::fixed_string<16>("a") < frozen::fixed_string<16>(frozen::string("a\0", 2)), "");
+  static_assert(frozen::fixed_string<16>("abcdefgh") < frozen::fixed_string<16>("abcdefghi"), "");
+  static_assert(frozen::fixed_string<16>("abcdefgi") > frozen::fixed_string<16>("abcdefghi"), "");
+
+  constexpr frozen::fixed_u32string<3> olaf = U"\U0001F600ab";
+  static_assert(olaf[0] == U'\U0001F600' && olaf[2] == U'b', "");
+
+  std::string const runtime = "Elsa";
+  REQUIRE(frozen::fixed_string<16>(frozen::string(runtime.data(), runtime.size())) == elsa);
+  REQUIRE_THROWS_AS(frozen::fixed_string<2>(runtime.data(), runtime.size()), std::length_error);
+
+  frozen::elsa<frozen::fixed_string<16>> const hash;
+  REQUIRE(hash(elsa, 7) == hash(frozen::fixed_string<16>("Elsa"), 7));
+  REQUIRE(hash(elsa, 7) != hash(frozen::fixed_string<16>("Elsb"), 7));
+}
+
+TEST_CASE("fixed string keys", "[fixed string]") {
+  constexpr auto keywords = frozen::make_unordered_map<frozen::fixed_string<8>, int>({
+      {"auto", 1}, {"break", 2}, {"case", 3}, {"continue", 4}, {"default", 5}, {"do", 6}});
+  static_assert(keywords.at("continue") == 4, "");
+  static_assert(keywords.count("goto") == 0, "");
+  REQUIRE(keywords.at(frozen::string("do")) == 6);
+
+  constexpr frozen::unordered_set<frozen::fixed_string<8>, 3> colors = {"red", "green", "blue"};
+  static_assert(colors.count("green"), "");
+  static_assert(!colors.count("yellow"), "");
+
+  constexpr frozen::map<frozen::fixed_string<8>, int, 3> ordered = {{"b", 2}, {"a", 1}, {"c", 3}};
+  static_assert(ordered.at("b") == 2, "");
+  static_assert(ordered.begin()->first == frozen::fixed_string<8>("a"), "");
+
+  constexpr frozen::set<frozen::fixed_string<8>, 3> words = {"snow", "ice", "frost"};
+  static_assert(words.count("ice"), "");
+  static_assert(!words.count("rain"), "");
+}
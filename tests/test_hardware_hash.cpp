@@ -0,0 +1,124 @@
+#include <frozen/dynamic_unordered_set.h>
+#include <frozen/hardware_hash.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+#include <frozen/unordered_set.h>
+
+#include <cstdint>
+#include <string>
+
+#include "catch.hpp"
+
+// Known answers, from the Intel AES-NI white paper and the SSE 4.2 crc32
+// instruction.
+static constexpr frozen::bits::aes_block aes_state{0x63746f725d53475dull, 0x7b5b546573745665ull};
+static constexpr frozen::bits::aes_block aes_key{0x5b477565726f6e5dull, 0x4869285368617929ull};
+static_assert(frozen::bits::aesenc_soft(aes_state, aes_key).lo == 0x8b104b58ded7e595ull, "");
+static_assert(frozen::bits::aesenc_soft(aes_state, aes_key).hi == 0xa8311c2f9fdba3c5ull, "");
+static_assert(frozen::bits::crc32c_u64_soft(0xFFFFFFFFu, 0x3837363534333231ull) == 0x9F787F65u, "");
+
+static constexpr char text[] = "Let it go, let it go, can't hold it back anymore";
+static constexpr std::size_t text_size = sizeof(text) - 1;
+static constexpr char16_t wide_text[] = u"Let it go, let it go, turn away and slam the door";
+
+template <template <class> class Hash> struct hashes {
+  std::size_t ints[64] = {};
+  std::size_t strings[text_size + 1] = {};
+  std::size_t wide[text_size / 2 + 1] = {};
+
+  constexpr hashes() {
+    for (std::size_t i = 0; i < 64; ++i)
+      ints[i] = Hash<std::uint64_t>{}(std::uint64_t(1) << i | i, i * 0x1234567);
+    for (std::size_t i = 0; i <= text_size; ++i)
+      strings[i] = Hash<frozen::string>{}(frozen::string(text, i), i);
+    for (std::size_t i = 0; i <= text_size / 2; ++i)
+      wide[i] = Hash<frozen::u16string>{}(frozen::u16string(wide_text, i), i);
+  }
+};
+
+template <template <class> class Hash> void check_runtime(hashes<Hash> const &expected) {
+  // Out of reach of constant folding, so that the instructions are used.
+  std::string const copy = text;
+  std::u16string const wide_copy = wide_text;
+  volatile std::size_t seed_factor = 0x1234567;
+  for (std::size_t i = 0; i < 64; ++i)
+    REQUIRE(Hash<std::uint64_t>{}(std::uint64_t(1) << i | i, i * seed_factor) == expected.ints[i]);
+  for (std::size_t i = 0; i <= text_size; ++i)
+    REQUIRE(Hash<frozen::string>{}(frozen::string(copy.data(), i), i) == expected.strings[i]);
+  for (std::size_t i = 0; i <= text_size / 2; ++i)
+    REQUIRE(Hash<frozen::u16string>{}(frozen::u16string(wide_copy.data(), i), i) == expected.wide[i]);
+}
+
+TEST_CASE("crc hash constexpr and runtime", "[hardware hash]") {
+  constexpr hashes<frozen::crc_hash> expected{};
+  check_runtime(expected);
+
+#ifdef FROZEN_LETITGO_HAS_CRC32C
+  if (FROZEN_LETITGO_CRC32C_SUPPORTED()) {
+    volatile std::uint64_t word = 0x0123456789ABCDEFull;
+    for (std::uint32_t crc = 1; crc; crc <<= 1)
+      REQUIRE(frozen::bits::crc32c_u64_hard(crc, word) == frozen::bits::crc32c_u64_soft(crc, word));
+  }
+#endif
+}
+
+TEST_CASE("aes hash constexpr and runtime", "[hardware hash]") {
+  constexpr hashes<frozen::aes_hash> expected{};
+  check_runtime(expected);
+
+#ifdef FROZEN_LETITGO_HAS_AESENC
+  if (FROZEN_LETITGO_AESENC_SUPPORTED()) {
+    volatile std::uint64_t lo = aes_state.lo;
+    for (std::uint64_t hi = 1; hi; hi <<= 1) {
+      auto const hard = frozen::bits::aesenc_hard({lo, hi}, aes_key);
+      auto const soft = frozen::bits::aesenc_soft({lo, hi}, aes_key);
+      REQUIRE(hard.lo == soft.lo);
+      REQUIRE(hard.hi == soft.hi);
+    }
+  }
+#endif
+}
+
+TEST_CASE("containers with hardware hashes", "[hardware hash]") {
+  constexpr frozen::unordered_set<int, 5, frozen::crc_hash<int>> crc_ints{{-2, 3, 5, 7, 1 << 20}, {}, {}};
+  static_assert(crc_ints.count(7) && !crc_ints.count(8), "");
+  constexpr frozen::unordered_map<unsigned, int, 4, frozen::aes_hash<unsigned>> aes_ints{
+      {{1, 1}, {10, 2}, {100, 3}, {1000, 4}}, {}, {}};
+  static_assert(aes_ints.at(100) == 3, "");
+
+  constexpr frozen::unordered_map<frozen::string, int, 4, frozen::crc_hash<frozen::string>> crc_strings{
+      {{"Anna", 1}, {"Elsa", 2}, {"Olaf", 3}, {"Kristoff and Sven", 4}}, {}, {}};
+  constexpr frozen::unordered_set<frozen::string, 4, frozen::aes_hash<frozen::string>> aes_strings{
+      {"Anna", "Elsa", "Olaf", "Kristoff and Sven"}, {}, {}};
+  for (std::string key : {"Anna", "Elsa", "Olaf", "Kristoff and Sven"}) {
+    REQUIRE(crc_strings.count(frozen::string(key.data(), key.size())) == 1);
+    REQUIRE(aes_strings.count(frozen::string(key.data(), key.size())) == 1);
+  }
+  for (std::string key : {std::string(), std::string("Hans"), std::string("Anna\0", 5), std::string("Kristoff and Sve")}) {
+    REQUIRE(crc_strings.count(frozen::string(key.data(), key.size())) == 0);
+    REQUIRE(aes_strings.count(frozen::string(key.data(), key.size())) == 0);
+  }
+  REQUIRE(crc_ints.count(-2) == 1);
+  REQUIRE(aes_ints.find(11) == aes_ints.end());
+}
+
+TEST_CASE("crc hash of keys with the same crc", "[hardware hash]") {
+  // Both pairs have the same CRC32C, whatever its initial value.
+  constexpr std::uint64_t first = 0xc788461c0fe23c23ull, second = 0xed39b64e9477a7c1ull;
+  constexpr frozen::unordered_set<std::uint64_t, 2, frozen::crc_hash<std::uint64_t>> ints{{first, second}, {}, {}};
+  static_assert(ints.count(first) && ints.count(second), "");
+  constexpr frozen::unordered_set<frozen::string, 2, frozen::crc_hash<frozen::string>> strings{
+      {"dwkaqxdxddes", "rgjaxaguixaz"}, {}, {}};
+  static_assert(strings.count("dwkaqxdxddes") && strings.count("rgjaxaguixaz"), "");
+
+  frozen::dynamic_unordered_set<std::uint64_t, frozen::crc_hash<std::uint64_t>> const dynamic_ints{first, second};
+  REQUIRE(dynamic_ints.count(first) == 1);
+  REQUIRE(dynamic_ints.count(second) == 1);
+
+  std::string const first_string = "dwkaqxdxddes", second_string = "rgjaxaguixaz";
+  for (std::size_t seed = 0; seed < 64; ++seed) {
+    REQUIRE(frozen::crc_hash<std::uint64_t>{}(first, seed) != frozen::crc_hash<std::uint64_t>{}(second, seed));
+    REQUIRE(frozen::crc_hash<frozen::string>{}(frozen::string(first_string.data(), first_string.size()), seed) !=
+            frozen::crc_hash<frozen::string>{}(frozen::string(second_string.data(), second_string.size()), seed));
+  }
+}
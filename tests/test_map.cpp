@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <frozen/map.h>
+#include <frozen/string.h>
 #include <functional>
 #include <iostream>
 #include <map>
@@ -508,3 +509,8 @@ TEST_CASE("frozen::map constexpr std::pair key", "[map]") {
       {{1, 2}, 5}, {{3, 4}, 6}};
   static_assert(ce2.at({3, 4}) == 6, "");
 }
+
+TEST_CASE("frozen::map index_of", "[map]") {
+  constexpr frozen::map<frozen::string, int, 3> names = {{"Olaf", 1}, {"Anna", 2}, {"Elsa", 3}};
+  static_assert(names.index_of("Anna") == 0 && names.index_of("Olaf") == 2 && names.index_of("Hans") == 3, "");
+}
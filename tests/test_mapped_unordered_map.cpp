@@ -0,0 +1,120 @@
+#include <frozen/dynamic_unordered_map.h>
+#include <frozen/mapped_unordered_map.h>
+#include <frozen/string.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "catch.hpp"
+
+TEST_CASE("mapped unordered map of integers", "[mapped unordered map]") {
+  std::vector<std::pair<std::uint32_t, double>> items;
+  for (std::uint32_t i = 0; i < 1000; ++i)
+    items.emplace_back(i * 31, i / 2.);
+  frozen::dynamic_unordered_map<std::uint32_t, double> const built(items.begin(), items.end());
+
+  auto const image = frozen::serialize(built);
+  frozen::mapped_unordered_map<std::uint32_t, double> const ze_map(image.data(), image.size());
+
+  REQUIRE(ze_map.size() == built.size());
+  REQUIRE(ze_map.bucket_count() == built.bucket_count());
+  for (auto const &item : items) {
+    REQUIRE(ze_map.at(item.first) == item.second);
+    REQUIRE((*ze_map.find(item.first)).second == item.second);
+  }
+  REQUIRE(!ze_map.contains(1u));
+  REQUIRE(ze_map.find(1u) == ze_map.end());
+  REQUIRE_THROWS_AS(ze_map.at(1u), std::out_of_range);
+
+  std::size_t visited = 0;
+  for (auto const item : ze_map)
+    visited += built.at(item.first) == item.second;
+  REQUIRE(visited == items.size());
+}
+
+TEST_CASE("mapped unordered map of sharded tables", "[mapped unordered map]") {
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> items;
+  for (std::uint64_t i = 0; i < 50000; ++i)
+    items.emplace_back(i * 7919, i);
+  frozen::dynamic_unordered_map<std::uint64_t, std::uint64_t> const built(
+      items.begin(), items.end(), frozen::parallel_build{2});
+
+  auto const image = frozen::serialize(built);
+  frozen::mapped_unordered_map<std::uint64_t, std::uint64_t> const ze_map(image.data(), image.size());
+  for (auto const &item : items)
+    REQUIRE(ze_map.at(item.first) == item.second);
+  for (std::uint64_t i = 0; i < 50000; ++i)
+    REQUIRE(!ze_map.contains(i * 7919 + 1));
+}
+
+TEST_CASE("mapped unordered map of strings", "[mapped unordered map]") {
+  std::vector<std::string> const names{"elsa", "anna", "olaf", "", "kristoff", "sven"};
+  std::vector<std::pair<frozen::string, int>> items;
+  for (auto const &name : names)
+    items.emplace_back(frozen::string(name.data(), name.size()), static_cast<int>(name.size()));
+
+  frozen::dynamic_unordered_map<frozen::string, int> const built(items.begin(), items.end());
+  auto const image = frozen::serialize(built);
+  frozen::mapped_unordered_map<frozen::string, int> const ze_map(image.data(), image.size());
+
+  for (auto const &item : items)
+    REQUIRE(ze_map.at(item.first) == item.second);
+  REQUIRE(!ze_map.contains(frozen::string("hans")));
+
+  // Keys point into the image, not into the original strings.
+  auto const where = *ze_map.find(frozen::string("olaf"));
+  REQUIRE(where.first == "olaf");
+  REQUIRE(reinterpret_cast<unsigned char const *>(where.first.data()) >= image.data());
+  REQUIRE(reinterpret_cast<unsigned char const *>(where.first.data()) < image.data() + image.size());
+}
+
+TEST_CASE("mapped unordered map rejects invalid images", "[mapped unordered map]") {
+  std::vector<std::pair<int, int>> const items{{1, 2}, {3, 4}};
+  frozen::dynamic_unordered_map<int, int> const built(items.begin(), items.end());
+  auto image = frozen::serialize(built);
+
+  using int_map = frozen::mapped_unordered_map<int, int>;
+  REQUIRE_THROWS_AS(int_map(image.data(), 16), std::invalid_argument);
+  REQUIRE_THROWS_AS(int_map(image.data(), image.size() - 1), std::invalid_argument);
+  REQUIRE_THROWS_AS((frozen::mapped_unordered_map<int, double>(image.data(), image.size())), std::invalid_argument);
+  REQUIRE_THROWS_AS((frozen::mapped_unordered_map<frozen::string, int>(image.data(), image.size())), std::invalid_argument);
+
+  image[offsetof(frozen::bits::mapped_header, count)] ^= 1;
+  REQUIRE_THROWS_AS(int_map(image.data(), image.size()), std::invalid_argument);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+TEST_CASE("mapped unordered map from a file", "[mapped unordered map]") {
+  std::vector<std::pair<frozen::string, std::uint64_t>> items{
+      {"tenant-a", 1}, {"tenant-b", 2}, {"tenant-c", 3}};
+  auto const image = frozen::serialize(
+      frozen::dynamic_unordered_map<frozen::string, std::uint64_t>(items.begin(), items.end()));
+
+  char path[] = "/tmp/frozen_mappedXXXXXX";
+  int const fd = mkstemp(path);
+  REQUIRE(fd >= 0);
+  REQUIRE(write(fd, image.data(), image.size()) == static_cast<ssize_t>(image.size()));
+
+  void *const mapped = mmap(nullptr, image.size(), PROT_READ, MAP_SHARED, fd, 0);
+  REQUIRE(mapped != MAP_FAILED);
+  {
+    frozen::mapped_unordered_map<frozen::string, std::uint64_t> const ze_map(mapped, image.size());
+    for (auto const &item : items)
+      REQUIRE(ze_map.at(item.first) == item.second);
+  }
+  munmap(mapped, image.size());
+  close(fd);
+  std::remove(path);
+}
+#endif
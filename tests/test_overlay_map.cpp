@@ -0,0 +1,83 @@
+#include <frozen/map.h>
+#include <frozen/overlay_map.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+static constexpr frozen::unordered_map<frozen::string, int, 3> Flags{
+    {"dark-mode", 0}, {"beta", 1}, {"telemetry", 1}};
+
+TEST_CASE("overlay map without overlay", "[overlay map]") {
+  frozen::overlay_map<decltype(Flags)> const flags(Flags);
+
+  REQUIRE(flags.size() == 3);
+  REQUIRE(flags.overlay_size() == 0);
+  REQUIRE(flags.at(frozen::string("beta")) == 1);
+  REQUIRE(flags.find(frozen::string("beta")) == &Flags.at(frozen::string("beta")));
+  REQUIRE(!flags.contains(frozen::string("canary")));
+  REQUIRE_THROWS_AS(flags.at(frozen::string("canary")), std::out_of_range);
+}
+
+TEST_CASE("overlay map overrides, inserts and erases", "[overlay map]") {
+  auto flags = frozen::make_overlay_map(Flags);
+
+  REQUIRE(!flags.insert_or_assign("beta", 0));
+  REQUIRE(flags.at(frozen::string("beta")) == 0);
+  REQUIRE(Flags.at(frozen::string("beta")) == 1);
+  REQUIRE(flags.size() == 3);
+
+  REQUIRE(flags.insert_or_assign("canary", 1));
+  REQUIRE(!flags.insert_or_assign("canary", 2));
+  REQUIRE(flags.at(frozen::string("canary")) == 2);
+  REQUIRE(flags.size() == 4);
+
+  REQUIRE(flags.erase(frozen::string("telemetry")) == 1);
+  REQUIRE(flags.erase(frozen::string("telemetry")) == 0);
+  REQUIRE(flags.erase(frozen::string("unknown")) == 0);
+  REQUIRE(!flags.contains(frozen::string("telemetry")));
+  REQUIRE(flags.size() == 3);
+
+  REQUIRE(flags.erase(frozen::string("canary")) == 1);
+  REQUIRE(!flags.contains(frozen::string("canary")));
+  REQUIRE(flags.insert_or_assign("telemetry", 5));
+  REQUIRE(flags.at(frozen::string("telemetry")) == 5);
+  REQUIRE(flags.size() == 3);
+
+  auto const frozen_flags = flags.freeze();
+  REQUIRE(frozen_flags.size() == 3);
+  REQUIRE(frozen_flags.at(frozen::string("dark-mode")) == 0);
+  REQUIRE(frozen_flags.at(frozen::string("beta")) == 0);
+  REQUIRE(frozen_flags.at(frozen::string("telemetry")) == 5);
+  REQUIRE(!frozen_flags.contains(frozen::string("canary")));
+
+  flags.clear_overlay();
+  REQUIRE(flags.size() == 3);
+  REQUIRE(flags.at(frozen::string("beta")) == 1);
+}
+
+TEST_CASE("overlay map over an ordered map", "[overlay map]") {
+  static constexpr frozen::map<int, int, 4> base{{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+  frozen::overlay_map<decltype(base)> ze_map(base);
+
+  // Enough keys to grow the overlay a few times.
+  for (int i = 0; i < 1000; ++i)
+    ze_map.insert_or_assign(i, -i);
+  REQUIRE(ze_map.size() == 1000);
+  REQUIRE(ze_map.overlay_size() == 1000);
+  for (int i = 0; i < 1000; i += 2)
+    REQUIRE(ze_map.erase(i) == 1);
+  REQUIRE(ze_map.size() == 500);
+
+  for (int i = 0; i < 1000; ++i)
+    REQUIRE(ze_map.contains(i) == (i % 2 == 1));
+
+  auto const frozen_map = ze_map.freeze();
+  REQUIRE(frozen_map.size() == 500);
+  for (int i = 1; i < 1000; i += 2)
+    REQUIRE(frozen_map.at(i) == -i);
+}
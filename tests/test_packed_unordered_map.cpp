@@ -0,0 +1,47 @@
+#include <frozen/packed_unordered_map.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "catch.hpp"
+
+static constexpr std::pair<frozen::string, int> Voices[] = {
+    {"Anna", 1}, {"Elsa", 2}, {"Olaf", 3}, {"Kristoff", 4}, {"", 5}};
+
+TEST_CASE("packed unordered map", "[packed unordered map]") {
+  constexpr auto voices = frozen::make_packed_unordered_map<frozen::packed_chars(Voices)>(Voices);
+  static_assert(frozen::packed_chars(Voices) == 20, "");
+  static_assert(voices.size() == 5, "");
+  static_assert(voices.at(frozen::string("Kristoff")) == 4, "");
+  static_assert(voices.count(frozen::string("Hans")) == 0, "");
+  static_assert(voices.contains(frozen::string("")), "");
+
+  REQUIRE(voices.find(frozen::string("Olaf")) != voices.end());
+  REQUIRE((*voices.find(frozen::string("Olaf"))).first == frozen::string("Olaf"));
+  REQUIRE((*voices.find(frozen::string("Olaf"))).second == 3);
+  REQUIRE(voices.find(frozen::string("Sven")) == voices.end());
+  REQUIRE_THROWS_AS(voices.at(frozen::string("Sven")), std::out_of_range);
+
+  // Keys are rebuilt from the blob, not from the original strings.
+  std::string const elsa = "Elsa";
+  REQUIRE(voices.at(frozen::string(elsa.data(), elsa.size())) == 2);
+  REQUIRE((*voices.find(frozen::string(elsa.data(), elsa.size()))).first.data() != elsa.data());
+
+  // Same keys and values as a plain unordered_map.
+  constexpr auto plain = frozen::make_unordered_map(Voices);
+  int visited = 0;
+  for (auto item : voices) {
+    REQUIRE(plain.at(item.first) == item.second);
+    ++visited;
+  }
+  REQUIRE(visited == 5);
+}
+
+TEST_CASE("packed unordered map with spare characters", "[packed unordered map]") {
+  frozen::packed_unordered_map<frozen::string, int, 2, 64> voices = {{"Anna", 1}, {"Elsa", 2}};
+  voices.at(frozen::string("Anna")) = 10;
+  REQUIRE(voices.at(frozen::string("Anna")) == 10);
+  REQUIRE(voices.at(frozen::string("Elsa")) == 2);
+}
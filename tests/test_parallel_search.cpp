@@ -0,0 +1,95 @@
+#include <frozen/parallel_search.h>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+static std::string make_haystack(std::size_t size) {
+  std::string haystack;
+  haystack.reserve(size);
+  unsigned state = 1;
+  while (haystack.size() < size) {
+    state = state * 1103515245u + 12345u;
+    switch ((state >> 16) % 5) {
+      case 0: haystack += "let it go "; break;
+      case 1: haystack += "let it snow "; break;
+      case 2: haystack += "aaaa"; break;
+      default: haystack += static_cast<char>('a' + (state >> 8) % 26);
+    }
+  }
+  return haystack;
+}
+
+TEST_CASE("parallel_search matches frozen::search", "[parallel-search]") {
+  std::string const haystack = make_haystack(1 << 20);
+
+  auto const kmp = frozen::make_knuth_morris_pratt_searcher("let it go");
+  auto const bm = frozen::make_boyer_moore_searcher("let it go");
+  for (unsigned threads : {1u, 2u, 3u, 8u}) {
+    REQUIRE(frozen::parallel_search(haystack.begin(), haystack.end(), kmp, threads) ==
+            frozen::search(haystack.begin(), haystack.end(), kmp));
+    REQUIRE(frozen::parallel_search(haystack.begin(), haystack.end(), bm, threads) ==
+            frozen::search(haystack.begin(), haystack.end(), bm));
+  }
+
+  auto const missing = frozen::make_boyer_moore_searcher("let it be");
+  REQUIRE(frozen::parallel_search(haystack.begin(), haystack.end(), missing, 4) == haystack.end());
+}
+
+TEST_CASE("parallel_find_all reports every match once, in order", "[parallel-search]") {
+  std::string const haystack = make_haystack(1 << 20) + "let it go";
+
+  for (std::string const needle : {"let it go", "aaa", "t i"}) {
+    std::vector<std::string::const_iterator> expected;
+    for (auto where = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end());
+         where != haystack.end();
+         where = std::search(where + 1, haystack.end(), needle.begin(), needle.end()))
+      expected.push_back(where);
+
+    frozen::runtime_boyer_moore_searcher<16> const bm(needle.data(), needle.size());
+    frozen::runtime_knuth_morris_pratt_searcher<16> const kmp(needle.data(), needle.size());
+    for (unsigned threads : {1u, 2u, 5u, 16u}) {
+      std::vector<std::string::const_iterator> found;
+      frozen::parallel_find_all(haystack.begin(), haystack.end(), bm, std::back_inserter(found), threads);
+      REQUIRE(found == expected);
+
+      found.clear();
+      frozen::parallel_find_all(haystack.begin(), haystack.end(), kmp, std::back_inserter(found), threads);
+      REQUIRE(found == expected);
+    }
+  }
+}
+
+namespace {
+// Searcher that fails on the chunks past a given offset of the haystack.
+struct failing_searcher {
+  std::string::const_iterator fail_from;
+
+  std::size_t size() const { return 4; }
+  std::pair<std::string::const_iterator, std::string::const_iterator>
+  operator()(std::string::const_iterator first, std::string::const_iterator last) const {
+    if (!(first < fail_from))
+      throw std::runtime_error("search failed");
+    return {last, last};
+  }
+};
+} // namespace
+
+TEST_CASE("parallel searches rethrow the exceptions of the searcher", "[parallel-search]") {
+  std::string const haystack = make_haystack(1 << 20);
+  failing_searcher const searcher{haystack.begin() + haystack.size() / 2};
+
+  for (unsigned threads : {1u, 2u, 5u, 16u}) {
+    REQUIRE_THROWS_AS(frozen::parallel_search(haystack.begin(), haystack.end(), searcher, threads),
+                      std::runtime_error);
+    std::vector<std::string::const_iterator> found;
+    REQUIRE_THROWS_AS(frozen::parallel_find_all(haystack.begin(), haystack.end(), searcher,
+                                                std::back_inserter(found), threads),
+                      std::runtime_error);
+  }
+}
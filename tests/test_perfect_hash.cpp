@@ -0,0 +1,55 @@
+#include <frozen/perfect_hash.h>
+#include <frozen/string.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+static constexpr frozen::string c_keywords[] = {
+    "auto",     "break",  "case",    "char",   "const",    "continue",
+    "default",  "do",     "double",  "else",   "enum",     "extern",
+    "float",    "for",    "goto",    "if",     "int",      "long",
+    "register", "return", "short",   "signed", "sizeof",   "static",
+    "struct",   "switch", "typedef", "union",  "unsigned", "void",
+    "volatile", "while"};
+
+TEST_CASE("perfect hash of strings", "[perfect hash]") {
+  constexpr auto hash = frozen::make_perfect_hash(c_keywords);
+  static_assert(hash.size() == 32, "");
+  static_assert(hash("auto") == 0, "");
+  static_assert(hash("while") == 31, "");
+
+  // Keys map to their index, so a plain array holds their values.
+  std::vector<int> seen(hash.size());
+  for (std::size_t i = 0; i < hash.size(); ++i) {
+    REQUIRE(hash(c_keywords[i]) == i);
+    ++seen[hash(c_keywords[i])];
+  }
+  for (auto count : seen)
+    REQUIRE(count == 1);
+
+  // Other keys give some index in the tables, not checked.
+  std::string const other = "inline";
+  REQUIRE(hash(frozen::string(other.data(), other.size())) <= hash.size());
+}
+
+TEST_CASE("perfect hash of integers", "[perfect hash]") {
+  // Tried with a single level first, as unordered_set.
+  constexpr unsigned ids[] = {1804289383, 846930886, 1681692777, 1714636915, 1957747793, 424238335};
+  constexpr auto hash = frozen::make_perfect_hash(ids);
+  static_assert(hash(1714636915u) == 3, "");
+  for (std::size_t i = 0; i < 6; ++i)
+    REQUIRE(hash(ids[i]) == i);
+
+  std::array<unsigned, 6> const runtime_ids = {{5, 4, 3, 2, 1, 0}};
+  auto const runtime_hash = frozen::make_perfect_hash(runtime_ids);
+  for (std::size_t i = 0; i < runtime_ids.size(); ++i)
+    REQUIRE(runtime_hash(runtime_ids[i]) == i);
+
+  struct custom_hash : frozen::elsa<int> {};
+  constexpr int keys[] = {-5, 0, 5, 1 << 24};
+  constexpr auto custom = frozen::make_perfect_hash(keys, custom_hash{}, std::equal_to<int>{});
+  static_assert(custom(1 << 24) == 3 && custom(-5) == 0, "");
+}
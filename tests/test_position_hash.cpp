@@ -0,0 +1,70 @@
+#include <frozen/position_hash.h>
+#include <frozen/string.h>
+#include <frozen/unordered_map.h>
+#include <frozen/unordered_set.h>
+
+#include <string>
+
+#include "catch.hpp"
+
+static constexpr frozen::string c_keywords[] = {
+    "auto",     "break",  "case",    "char",   "const",    "continue",
+    "default",  "do",     "double",  "else",   "enum",     "extern",
+    "float",    "for",    "goto",    "if",     "int",      "long",
+    "register", "return", "short",   "signed", "sizeof",   "static",
+    "struct",   "switch", "typedef", "union",  "unsigned", "void",
+    "volatile", "while"};
+
+static constexpr std::pair<frozen::string, int> http_methods[] = {
+    {"GET", 0},   {"HEAD", 1},    {"POST", 2},  {"PUT", 3},  {"DELETE", 4},
+    {"CONNECT", 5}, {"OPTIONS", 6}, {"TRACE", 7}, {"PATCH", 8}};
+
+TEST_CASE("position hash selection", "[position hash]") {
+  constexpr auto keywords = frozen::make_position_hash(c_keywords);
+  static_assert(keywords.position_count() > 0, "");
+  static_assert(keywords.position_count() <= frozen::bits::position_hash_positions, "");
+
+  // The third last character and the length tell the methods apart.
+  constexpr auto methods = frozen::make_position_hash(http_methods);
+  static_assert(methods.position_count() == 1, "");
+  static_assert(methods.position(0) == -3, "");
+
+  // Keys of different lengths only need their length.
+  constexpr frozen::string lengths[] = {"a", "ab", "abc"};
+  static_assert(frozen::make_position_hash(lengths).position_count() == 0, "");
+
+  // Keys only told apart past the window fall back to every character.
+  constexpr frozen::string far[] = {"0123456789abcdefghijklmnopqrstuvwxyz0123456789",
+                                    "0123456789abcdefghijkLmnopqrstuvwxyz0123456789"};
+  constexpr auto fallback = frozen::make_position_hash(far);
+  static_assert(fallback.position_count() == frozen::position_hash::all_characters, "");
+  static_assert(fallback(far[0], 1) == frozen::elsa<frozen::string>{}(far[0], 1), "");
+}
+
+TEST_CASE("positional unordered set", "[position hash]") {
+  constexpr auto keywords = frozen::make_positional_unordered_set(c_keywords);
+  static_assert(keywords.size() == 32, "");
+  static_assert(keywords.count("volatile"), "");
+  static_assert(!keywords.count("volatil"), "");
+
+  for (auto keyword : c_keywords) {
+    std::string const copy(keyword.data(), keyword.size());
+    REQUIRE(keywords.count(frozen::string(copy.data(), copy.size())) == 1);
+  }
+  // Same length and last characters, but another key.
+  std::string const lookalike = "cxntinue";
+  REQUIRE(keywords.count(frozen::string(lookalike.data(), lookalike.size())) == 0);
+  REQUIRE(keywords.count("") == 0);
+  REQUIRE(keywords.count("i") == 0);
+  REQUIRE(keywords.count("whiles") == 0);
+}
+
+TEST_CASE("positional unordered map", "[position hash]") {
+  constexpr auto methods = frozen::make_positional_unordered_map(http_methods);
+  static_assert(methods.at("OPTIONS") == 6, "");
+
+  for (auto const &method : http_methods)
+    REQUIRE(methods.at(method.first) == method.second);
+  REQUIRE(methods.find("GOT") == methods.end());
+  REQUIRE(methods.find("PATCHES") == methods.end());
+}
@@ -316,3 +316,10 @@ TEST_CASE("frozen::set deduction guide", "[set]") {
 }
 
 #endif // FROZEN_LETITGO_HAS_DEDUCTION_GUIDES
+
+TEST_CASE("frozen::set index_of", "[set]") {
+  constexpr frozen::set<int, 4> ordered = {30, 10, 40, 20};
+  static_assert(ordered.index_of(10) == 0 && ordered.index_of(40) == 3 && ordered.index_of(25) == 4, "");
+  constexpr frozen::set<int, 0> none = {};
+  static_assert(none.index_of(1) == 0, "");
+}
@@ -1,6 +1,10 @@
 #include <frozen/string.h>
 #include <frozen/algorithm.h>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include <iostream>
 
 #ifdef FROZEN_LETITGO_HAS_STRING_VIEW
@@ -203,6 +207,49 @@ TEST_CASE("Various u8string operation", "[string]") {
 }
 #endif
 
+// Reference character loops, as used during constant evaluation.
+template <class Char>
+static bool reference_less(std::basic_string<Char> const &lhs, std::basic_string<Char> const &rhs) {
+  for (std::size_t i = 0; i < lhs.size() && i < rhs.size(); ++i)
+    if (lhs[i] != rhs[i])
+      return lhs[i] < rhs[i];
+  return lhs.size() < rhs.size();
+}
+
+template <class Char>
+static void test_runtime_comparisons(Char high) {
+  // Mismatches at every position of long strings, on both sides of the
+  // block boundaries, with characters that are negative when Char is signed.
+  std::basic_string<Char> const base(70, Char('a'));
+  std::vector<std::basic_string<Char>> strings = {{}, base, base.substr(0, 16), base.substr(0, 17)};
+  for (std::size_t i = 0; i < base.size(); ++i) {
+    for (Char c : {Char('b'), Char('A'), high}) {
+      auto changed = base;
+      changed[i] = c;
+      strings.push_back(changed);
+      strings.push_back(changed.substr(0, i + 1));
+    }
+  }
+  for (auto const &lhs : strings) {
+    for (auto const &rhs : strings) {
+      frozen::basic_string<Char> const l(lhs.data(), lhs.size()), r(rhs.data(), rhs.size());
+      REQUIRE((l == r) == (lhs == rhs));
+      REQUIRE((l < r) == reference_less(lhs, rhs));
+    }
+  }
+}
+
+TEST_CASE("Runtime string comparisons", "[string]") {
+  test_runtime_comparisons<char>(static_cast<char>(0xE9));
+  test_runtime_comparisons<wchar_t>(static_cast<wchar_t>(0x8000E9));
+  test_runtime_comparisons<char16_t>(u'\xE9');
+
+  constexpr frozen::string longer = "Let it go, let it go, can't hold it back anymore";
+  constexpr frozen::string shorter = "Let it go, let it go, can't hold it back any";
+  static_assert(shorter < longer && !(longer < shorter) && !(longer == shorter), "");
+  REQUIRE((shorter < longer && !(longer < shorter) && !(longer == shorter)));
+}
+
 TEST_CASE("Knuth-Morris-Pratt str search", "[str-search]") {
 
   {
@@ -294,3 +341,225 @@ TEST_CASE("Boyer-Moore str search", "[str-search]") {
   }
 
 }
+
+TEST_CASE("Runtime Knuth-Morris-Pratt str search", "[str-search]") {
+  std::string const needles[] = {"n", "nn", "mm", "n*", "nnnn", "nmnn*", "ABCDABD", "aab", "abab"};
+  std::string const haystacks[] = {"n", "nmnn", "ABC ABCDAB ABCDABCDABDE", "aaab", "xxababab", ""};
+
+  for (auto const &needle : needles) {
+    frozen::runtime_knuth_morris_pratt_searcher<8> searcher(needle.data(), needle.size());
+    REQUIRE(searcher.size() == needle.size());
+    for (auto const &haystack : haystacks) {
+      auto index = frozen::search(haystack.begin(), haystack.end(), searcher);
+      REQUIRE(index == std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end()));
+    }
+  }
+
+  {
+    constexpr frozen::runtime_knuth_morris_pratt_searcher<16> searcher("ABCDABD", 7);
+    static constexpr char haystack[] = "ABC ABCDAB ABCDABCDABDE";
+    constexpr auto index = frozen::search(std::begin(haystack), std::end(haystack), searcher);
+    static_assert(index - std::begin(haystack) == 15, "constexpr runtime searcher");
+  }
+
+  REQUIRE_THROWS_AS(frozen::runtime_knuth_morris_pratt_searcher<4>("ABCDABD", 7), std::length_error);
+}
+
+TEST_CASE("Runtime Boyer-Moore str search", "[str-search]") {
+  std::string const needles[] = {"n", "nn", "mm", "n*", "nnnn", "nmnn*", "ABCDABD", "aab", "abab", "\xe9t\xe9"};
+  std::string const haystacks[] = {"n", "nmnn", "ABC ABCDAB ABCDABCDABDE", "aaab", "xxababab", "", "l'\xe9t\xe9 !"};
+
+  for (auto const &needle : needles) {
+    frozen::runtime_boyer_moore_searcher<8> searcher(needle.data(), needle.size());
+    REQUIRE(searcher.size() == needle.size());
+    for (auto const &haystack : haystacks) {
+      auto index = frozen::search(haystack.begin(), haystack.end(), searcher);
+      REQUIRE(index == std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end()));
+    }
+  }
+
+  {
+    constexpr frozen::runtime_boyer_moore_searcher<16> searcher("ABCDABD", 7);
+    static constexpr char haystack[] = "ABC ABCDAB ABCDABCDABDE";
+    constexpr auto index = frozen::search(std::begin(haystack), std::end(haystack), searcher);
+    static_assert(index - std::begin(haystack) == 15, "constexpr runtime searcher");
+  }
+
+#ifdef FROZEN_LETITGO_HAS_STRING_VIEW
+  {
+    std::string_view needle = "DAB";
+    frozen::runtime_boyer_moore_searcher<8> searcher(needle);
+    std::string haystack = "ABC ABCDAB ABCDABCDABDE";
+    auto index = frozen::search(haystack.begin(), haystack.end(), searcher);
+    REQUIRE(std::distance(haystack.begin(), index) == 7);
+  }
+#endif
+
+  REQUIRE_THROWS_AS(frozen::runtime_boyer_moore_searcher<4>("ABCDABD", 7), std::length_error);
+}
+
+template <class Searcher>
+std::vector<std::size_t> stream_search(Searcher const &searcher, std::string const &haystack, std::size_t chunk) {
+  std::vector<std::size_t> offsets;
+  auto stream = frozen::make_stream_searcher(searcher);
+  for (std::size_t start = 0; start < haystack.size(); start += chunk) {
+    auto const stop = std::min(start + chunk, haystack.size());
+    auto found = stream.feed(haystack.data() + start, haystack.data() + stop,
+                             [&](std::size_t offset) { offsets.push_back(offset); });
+    REQUIRE(found <= offsets.size());
+  }
+  REQUIRE(stream.offset() == haystack.size());
+  return offsets;
+}
+
+std::vector<std::size_t> all_occurrences(std::string const &haystack, std::string const &needle) {
+  std::vector<std::size_t> offsets;
+  for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1))
+    offsets.push_back(pos);
+  return offsets;
+}
+
+TEST_CASE("Streamed str search", "[str-search]") {
+  std::string const haystack = "ABC ABCDAB ABCDABCDABDE aaaaaaa ABCDABD ABCDABDABCDABD";
+  std::string const needles[] = {"ABCDABD", "aaa", "A", "DAB"};
+
+  for (auto const &needle : needles) {
+    auto const expected = all_occurrences(haystack, needle);
+    frozen::runtime_knuth_morris_pratt_searcher<8> kmp(needle.data(), needle.size());
+    frozen::runtime_boyer_moore_searcher<8> bm(needle.data(), needle.size());
+    for (std::size_t chunk : {1, 2, 3, 5, 7, 64}) {
+      REQUIRE(stream_search(kmp, haystack, chunk) == expected);
+      REQUIRE(stream_search(bm, haystack, chunk) == expected);
+    }
+  }
+
+  {
+    auto stream = frozen::make_stream_searcher(frozen::make_boyer_moore_searcher("ABCDABD"));
+    std::size_t count = 0;
+    char const first[] = "xxABCD", second[] = "ABDxxABC", third[] = "DABD";
+    count += stream.feed(std::begin(first), std::end(first) - 1, [](std::size_t offset) { REQUIRE(offset == 2); });
+    count += stream.feed(std::begin(second), std::end(second) - 1, [](std::size_t offset) { REQUIRE(offset == 2); });
+    count += stream.feed(std::begin(third), std::end(third) - 1, [](std::size_t offset) { REQUIRE(offset == 11); });
+    REQUIRE(count == 2);
+    stream.reset();
+    REQUIRE(stream.offset() == 0);
+  }
+}
+
+TEST_CASE("find_all str search", "[str-search]") {
+  std::string const haystack = "ABC ABCDAB ABCDABCDABDE aaaaaaa ABCDABD ABCDABDABCDABD abababa";
+  std::string const needles[] = {"ABCDABD", "aaa", "A", "DAB", "aba", "zzz"};
+
+  for (auto const &needle : needles) {
+    auto const overlapping = all_occurrences(haystack, needle);
+    std::vector<std::size_t> non_overlapping;
+    for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + needle.size()))
+      non_overlapping.push_back(pos);
+
+    frozen::runtime_knuth_morris_pratt_searcher<8> const kmp(needle.data(), needle.size());
+    frozen::runtime_boyer_moore_searcher<8> const bm(needle.data(), needle.size());
+
+    auto collect = [&haystack](auto const &matches) {
+      std::vector<std::size_t> offsets;
+      for (auto const &match : matches) {
+        REQUIRE(std::distance(match.first, match.second) == std::distance(matches.begin()->first, matches.begin()->second));
+        offsets.push_back(std::distance(haystack.begin(), match.first));
+      }
+      return offsets;
+    };
+
+    REQUIRE(collect(frozen::find_all(haystack.begin(), haystack.end(), kmp)) == overlapping);
+    REQUIRE(collect(frozen::find_all(haystack.begin(), haystack.end(), bm)) == overlapping);
+    REQUIRE(collect(frozen::find_all(haystack.begin(), haystack.end(), kmp, frozen::match_mode::non_overlapping)) == non_overlapping);
+    REQUIRE(collect(frozen::find_all(haystack.begin(), haystack.end(), bm, frozen::match_mode::non_overlapping)) == non_overlapping);
+
+    REQUIRE(frozen::find_all(haystack.begin(), haystack.end(), kmp).count() == overlapping.size());
+    REQUIRE(frozen::find_all(haystack.begin(), haystack.end(), bm).count() == overlapping.size());
+    REQUIRE(frozen::find_all(haystack.begin(), haystack.end(), bm, frozen::match_mode::non_overlapping).count() == non_overlapping.size());
+    REQUIRE(frozen::find_all(haystack.begin(), haystack.end(), bm).empty() == overlapping.empty());
+  }
+
+  {
+    static constexpr char haystack_[] = "aaaaaaaaaa";
+    constexpr auto kmp = frozen::make_knuth_morris_pratt_searcher("aaa");
+    constexpr auto bm = frozen::make_boyer_moore_searcher("aaa");
+    static_assert(frozen::find_all(std::begin(haystack_), std::end(haystack_) - 1, kmp).count() == 8, "constexpr find_all");
+    static_assert(frozen::find_all(std::begin(haystack_), std::end(haystack_) - 1, bm).count() == 8, "constexpr find_all");
+    static_assert(frozen::find_all(std::begin(haystack_), std::end(haystack_) - 1, bm, frozen::match_mode::non_overlapping).count() == 3,
+                  "constexpr find_all");
+  }
+}
+
+struct naive_searcher {
+  std::string needle;
+  std::size_t size() const { return needle.size(); }
+  template <class ForwardIterator>
+  std::pair<ForwardIterator, ForwardIterator> operator()(ForwardIterator first, ForwardIterator last) const {
+    auto const match = std::search(first, last, needle.begin(), needle.end());
+    return {match, match == last ? last : std::next(match, needle.size())};
+  }
+};
+
+TEST_CASE("find_all with a foreign searcher", "[str-search]") {
+  std::string const haystack = "abababa";
+  naive_searcher const searcher{"aba"};
+  REQUIRE(frozen::find_all(haystack.begin(), haystack.end(), searcher).count() == 3);
+  REQUIRE(frozen::find_all(haystack.begin(), haystack.end(), searcher, frozen::match_mode::non_overlapping).count() == 2);
+
+  std::vector<std::size_t> offsets;
+  auto stream = frozen::make_stream_searcher(frozen::make_boyer_moore_searcher("aba"));
+  stream.feed(haystack.begin(), haystack.begin() + 4, [&](std::size_t offset) { offsets.push_back(offset); });
+  stream.feed(haystack.begin() + 4, haystack.end(), [&](std::size_t offset) { offsets.push_back(offset); });
+  REQUIRE(offsets == std::vector<std::size_t>{0, 2, 4});
+}
+
+#if FROZEN_LETITGO_HAS_CXX17
+TEST_CASE("find_all with a std searcher", "[str-search]") {
+  std::string const haystack = "abababa";
+  std::string const needle = "aba";
+  std::boyer_moore_searcher<std::string::const_iterator> const searcher(needle.cbegin(), needle.cend());
+  auto const matches = frozen::find_all(haystack.cbegin(), haystack.cend(), searcher);
+  REQUIRE(matches.count() == 3);
+
+  std::vector<std::size_t> offsets;
+  for (auto const &match : matches) {
+    REQUIRE(match.second - match.first == 3);
+    offsets.push_back(static_cast<std::size_t>(match.first - haystack.cbegin()));
+  }
+  REQUIRE(offsets == std::vector<std::size_t>{0, 2, 4});
+  REQUIRE(frozen::find_all(haystack.cbegin(), haystack.cend(), searcher, frozen::match_mode::non_overlapping).count() == 2);
+}
+#endif
+
+TEST_CASE("Suffix array", "[str-search]") {
+  static constexpr char text[] = "mississippi banana bandana";
+  constexpr auto index = frozen::make_suffix_array(text);
+  std::string const corpus = text;
+
+  static_assert(index.size() == sizeof(text) - 1, "suffix array size");
+  static_assert(index.count("ssi") == 2, "constexpr count");
+  static_assert(index.count("ana") == 3, "constexpr count");
+  static_assert(index.contains("band"), "constexpr contains");
+  static_assert(!index.contains("bandanas"), "constexpr contains");
+
+  // suffixes are sorted and the LCP array is consistent
+  REQUIRE(index.lcp(0) == 0);
+  for (std::size_t i = 1; i < index.size(); ++i) {
+    auto const prev = corpus.substr(index[i - 1]), curr = corpus.substr(index[i]);
+    REQUIRE(prev < curr);
+    std::size_t common = 0;
+    while (common < prev.size() && common < curr.size() && prev[common] == curr[common])
+      ++common;
+    REQUIRE(index.lcp(i) == common);
+  }
+
+  for (std::string const needle : {"i", "ss", "issi", "ana", "an", "a", "mississippi banana bandana", "x", "banana bandanas", ""}) {
+    auto const expected = all_occurrences(corpus, needle);
+    auto const range = index.locate(frozen::string(needle.data(), needle.size()));
+    std::vector<std::size_t> found(range.first, range.second);
+    std::sort(found.begin(), found.end());
+    if (!needle.empty())
+      REQUIRE(found == expected);
+    REQUIRE(index.count(frozen::string(needle.data(), needle.size())) == found.size());
+  }
+}
@@ -0,0 +1,88 @@
+#include <frozen/dynamic_unordered_map.h>
+#include <frozen/swappable.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace {
+
+using table = frozen::dynamic_unordered_map<int, int>;
+
+// Every key of generation g maps to g, destroyed tables are poisoned.
+struct tracked_table {
+  table items;
+  std::atomic<int> *alive;
+  int generation;
+
+  tracked_table(int g, std::atomic<int> *counter)
+      : items{{1, g}, {2, g}, {3, g}}, alive(counter), generation(g) {
+    ++*alive;
+  }
+  ~tracked_table() {
+    generation = -1;
+    --*alive;
+  }
+};
+
+} // namespace
+
+TEST_CASE("swappable single thread", "[swappable]") {
+  std::atomic<int> alive{0};
+  frozen::swappable<tracked_table> ze_table(std::make_unique<tracked_table>(0, &alive), 2);
+  REQUIRE(ze_table.max_readers() == 2);
+
+  auto reader = ze_table.make_reader();
+  {
+    auto snapshot = reader.read();
+    REQUIRE(snapshot->items.at(1) == 0);
+  }
+
+  ze_table.publish(std::make_unique<tracked_table>(1, &alive));
+  REQUIRE(alive == 1);
+  REQUIRE(reader.read()->items.at(2) == 1);
+
+  auto previous = ze_table.exchange(std::make_unique<tracked_table>(2, &alive));
+  REQUIRE(previous->generation == 1);
+  REQUIRE(ze_table.unsafe_get().generation == 2);
+
+  auto other = ze_table.make_reader();
+  REQUIRE_THROWS_AS(ze_table.make_reader(), std::length_error);
+}
+
+TEST_CASE("swappable readers never see a reclaimed table", "[swappable]") {
+  std::atomic<int> alive{0};
+  frozen::swappable<tracked_table> ze_table(std::make_unique<tracked_table>(0, &alive), 8);
+
+  std::atomic<bool> done{false};
+  std::atomic<std::size_t> failures{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r)
+    readers.emplace_back([&] {
+      auto reader = ze_table.make_reader();
+      int last = 0;
+      while (!done.load()) {
+        auto snapshot = reader.read();
+        int const g = snapshot->generation;
+        if (g < last || snapshot->items.at(3) != g || snapshot->generation != g)
+          ++failures;
+        last = g;
+      }
+    });
+
+  for (int g = 1; g <= 50; ++g)
+    ze_table.publish(std::make_unique<tracked_table>(g, &alive));
+  done = true;
+  for (auto &thread : readers)
+    thread.join();
+
+  REQUIRE(failures == 0);
+  REQUIRE(alive == 1);
+  REQUIRE(ze_table.unsafe_get().generation == 50);
+}
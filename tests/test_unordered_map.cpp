@@ -275,3 +275,29 @@ TEST_CASE("frozen::unordered_map transparent container", "[unordered_map]") {
   REQUIRE(map.count(case_insensitive("TwO")) == 0);
   REQUIRE(map.count(case_insensitive("333")) == 0);
 }
+
+TEST_CASE("frozen::unordered_map unchecked lookups", "[unordered_map]") {
+  enum class color { red, green, blue, cyan, magenta, yellow };
+  static constexpr frozen::unordered_map<color, char const *, 6> names = {
+      {color::red, "red"},   {color::green, "green"},     {color::blue, "blue"},
+      {color::cyan, "cyan"}, {color::magenta, "magenta"}, {color::yellow, "yellow"}};
+  for (auto const &item : names) {
+    REQUIRE(names.find_unchecked(item.first) == names.find(item.first));
+    REQUIRE(names.index_unchecked(item.first) == static_cast<std::size_t>(names.find(item.first) - names.begin()));
+  }
+  static_assert(names.find_unchecked(color::cyan)->second[0] == 'c', "");
+
+  frozen::unordered_map<frozen::string, int, 3> counts = {{"Anna", 0}, {"Elsa", 0}, {"Olaf", 0}};
+  for (auto key : {"Elsa", "Olaf", "Elsa"})
+    ++counts.find_unchecked(frozen::string(key))->second;
+  REQUIRE(counts.at("Anna") == 0);
+  REQUIRE(counts.at("Elsa") == 2);
+  REQUIRE(counts.at("Olaf") == 1);
+}
+
+TEST_CASE("frozen::unordered_map index_of", "[unordered_map]") {
+  constexpr frozen::unordered_map<int, char, 3> letters = {{7, 'a'}, {3, 'b'}, {11, 'c'}};
+  for (std::size_t i = 0; i < letters.size(); ++i)
+    REQUIRE(letters.index_of(letters.begin()[i].first) == i);
+  REQUIRE(letters.index_of(8) == letters.size());
+}
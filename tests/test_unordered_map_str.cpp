@@ -1,6 +1,11 @@
+#include <frozen/dynamic_unordered_set.h>
 #include <frozen/string.h>
 #include <frozen/unordered_map.h>
+#include <frozen/unordered_set.h>
+#include <cctype>
 #include <iostream>
+#include <string>
+#include <vector>
 #include <unordered_map>
 
 #include "bench.hpp"
@@ -86,3 +91,46 @@ TEST_CASE("various frozen::unordered_map config", "[unordered_map]") {
   (void)olaf0;
   (void)olaf1;
 }
+
+TEST_CASE("frozen::unordered_map lookup by precomputed hash", "[unordered_map]") {
+  using hash = frozen::incremental_elsa<frozen::string>;
+  constexpr frozen::unordered_map<frozen::string, int, 6, hash> keywords = {
+      {"if", 1}, {"else", 2}, {"while", 3}, {"for", 4}, {"return", 5}, {"", 6}};
+
+  // Fed all at once, one character at a time, or in chunks: same hash.
+  constexpr auto whole = hash{}.base("return");
+  static_assert(whole == hash::state_type{}.update('r').update('e').update('t').update("urn", 3).finish(), "");
+  static_assert(keywords.find_hashed(frozen::string("return"), whole)->second == 5, "");
+  static_assert(keywords.find_hashed(frozen::string("returns"), hash{}.base("returns")) == keywords.end(), "");
+  static_assert(keywords.find_hashed(frozen::string(""), hash::state_type{}.finish())->second == 6, "");
+
+  // A lexer hashes each token while scanning it.
+  std::string const source = "while x for y if z else return w";
+  std::vector<int> found;
+  for (std::size_t i = 0; i < source.size();) {
+    if (std::isspace(static_cast<unsigned char>(source[i]))) {
+      ++i;
+      continue;
+    }
+    hash::state_type state;
+    std::size_t const start = i;
+    for (; i < source.size() && !std::isspace(static_cast<unsigned char>(source[i])); ++i)
+      state.update(source[i]);
+    frozen::string const token(source.data() + start, i - start);
+    auto const where = keywords.find_hashed(token, state.finish());
+    REQUIRE(where == keywords.find(token));
+    if (where != keywords.end())
+      found.push_back(where->second);
+  }
+  REQUIRE(found == std::vector<int>{3, 4, 1, 2, 5});
+
+  constexpr frozen::unordered_set<frozen::string, 3, hash> colors = {"red", "green", "blue"};
+  static_assert(colors.find_hashed(frozen::string("green"), hash{}.base("green")) != colors.end(), "");
+  static_assert(colors.find_hashed(frozen::string("cyan"), hash{}.base("cyan")) == colors.end(), "");
+
+  std::vector<frozen::string> const words = {"snow", "ice", "frost", "sleet"};
+  frozen::dynamic_unordered_set<frozen::string, hash> const weather(words.begin(), words.end());
+  for (auto word : words)
+    REQUIRE(weather.find_hashed(word, hash{}.base(word)) != weather.end());
+  REQUIRE(weather.find_hashed(frozen::string("rain"), hash{}.base("rain")) == weather.end());
+}
@@ -1,7 +1,9 @@
 #include <frozen/string.h>
 #include <frozen/unordered_set.h>
 #include <frozen/bits/elsa_std.h>
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include <unordered_set>
 #include <string>
 
@@ -198,3 +200,103 @@ TEST_CASE("frozen::unordered_set heterogeneous container", "[unordered_set]") {
   REQUIRE(set.find(std::string{"two"}) != set.end());
   REQUIRE(set.find(frozen::string{"two"}) != set.end());
 }
+
+TEST_CASE("frozen::unordered_set single level tables", "[unordered_set]") {
+  using frozen::bits::pmh_access;
+
+  // Dense and strided keys keep their order.
+  constexpr frozen::unordered_set<int, 8> dense = {7, 6, 5, 4, 3, 2, 1, 0};
+  static_assert(pmh_access::tables(dense).multiplier_ != 0, "");
+  static_assert((pmh_access::tables(dense).multiplier_ & (pmh_access::tables(dense).multiplier_ - 1)) == 0, "");
+  static_assert(dense.count(5) && !dense.count(8) && !dense.count(-1), "");
+
+  constexpr frozen::unordered_set<unsigned, 5> strided = {0, 8, 16, 24, 32};
+  static_assert(pmh_access::tables(strided).multiplier_ != 0, "");
+  static_assert(strided.count(24) && !strided.count(4) && !strided.count(40), "");
+
+  // Small sparse sets find an odd multiplier.
+  constexpr frozen::unordered_set<long, 12> sparse = {-4561, 93, 1 << 30, 77777, 5, 1234567,
+                                                      -1,    0,  42,      900001, 31337, 8};
+  static_assert(pmh_access::tables(sparse).multiplier_ != 0, "");
+  for (auto key : sparse)
+    REQUIRE(sparse.count(key) == 1);
+  REQUIRE(sparse.count(-2) == 0);
+  REQUIRE(sparse.count(43) == 0);
+
+  enum class some_enum { A = 4, B = 16, C = 64 };
+  constexpr frozen::unordered_set<some_enum, 2> enums = {some_enum::A, some_enum::C};
+  static_assert(pmh_access::tables(enums).multiplier_ != 0, "");
+  static_assert(enums.count(some_enum::C) && !enums.count(some_enum::B), "");
+
+  // Larger sparse sets fall back to two levels.
+  constexpr frozen::unordered_set<int, 129> large = {INIT_SEQ};
+  static_assert(pmh_access::tables(large).multiplier_ == 0, "");
+  static_assert(large.count(1115779988) && !large.count(3), "");
+
+  // So do custom hashers.
+  struct custom_hash : frozen::elsa<int> {};
+  constexpr frozen::unordered_set<int, 3, custom_hash> custom{{1, 2, 3}, custom_hash{}, std::equal_to<int>{}};
+  static_assert(std::is_same<std::remove_cv_t<std::remove_reference_t<decltype(pmh_access::tables(custom))>>,
+                             frozen::bits::pmh_tables<8, custom_hash>>::value, "");
+  static_assert(custom.count(2), "");
+}
+
+TEST_CASE("frozen::unordered_set unchecked lookups", "[unordered_set]") {
+  constexpr frozen::unordered_set<int, 6> ints = {-3, 10, 1 << 20, 7, 0, 123456};
+  for (auto key : ints) {
+    REQUIRE(ints.find_unchecked(key) == ints.find(key));
+    REQUIRE(*ints.find_unchecked(key) == key);
+  }
+  static_assert(*ints.find_unchecked(7) == 7, "");
+
+  constexpr frozen::unordered_set<frozen::string, 4> strings = {"Anna", "Elsa", "Olaf", "Kristoff"};
+  for (auto const &key : strings)
+    REQUIRE(strings.begin() + strings.index_unchecked(key) == strings.find(key));
+  static_assert(strings.begin()[strings.index_unchecked("Olaf")] == "Olaf", "");
+}
+
+TEST_CASE("frozen::unordered_set branchless tables", "[unordered_set]") {
+  using frozen::bits::pmh_access;
+  using hash = frozen::branchless_hash<frozen::elsa<int>>;
+
+  constexpr frozen::unordered_set<int, 129, hash> ints = {INIT_SEQ};
+  static_assert(std::is_same<std::remove_cv_t<std::remove_reference_t<decltype(pmh_access::tables(ints))>>,
+                             frozen::bits::pmh_branchless_tables<256, hash>>::value, "");
+  static_assert(ints.count(1115779988) && !ints.count(3), "");
+  for (auto key : ints)
+    REQUIRE(ints.count(key) == 1);
+  for (int key = -100; key < 100; ++key)
+    REQUIRE(ints.count(key) == (std::find(ints.begin(), ints.end(), key) != ints.end()));
+
+  // Every key goes through a multiplier, buckets of a single key included.
+  auto const &tables = pmh_access::tables(ints);
+  for (auto key : ints) {
+    std::uint64_t const first = ints.hash_function()(key, tables.first_seed_);
+    auto const multiplier = tables.first_table_[first & 255];
+    REQUIRE(multiplier % 2 == 1);
+    REQUIRE(ints.begin()[tables.second_table_[(first * multiplier) >> 56]] == key);
+  }
+
+  constexpr frozen::unordered_set<frozen::string, 4, frozen::branchless_hash<frozen::elsa<frozen::string>>> strings = {
+      "Anna", "Elsa", "Olaf", "Kristoff"};
+  static_assert(strings.contains("Olaf") && !strings.contains("Hans"), "");
+  static_assert(*strings.find_unchecked("Elsa") == "Elsa", "");
+}
+
+TEST_CASE("frozen::unordered_set duplicate keys", "[unordered_set]") {
+  // At runtime, no seed could ever tell the copies of a key apart.
+  volatile int duplicate = 7;
+  int const a = duplicate;
+  REQUIRE_THROWS_AS((frozen::unordered_set<int, 3>{a, 2, a}), std::invalid_argument);
+  REQUIRE_THROWS_AS((frozen::unordered_set<int, 3, frozen::branchless_hash<frozen::elsa<int>>>{a, 2, a}),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS((frozen::unordered_set<int, 4, frozen::branchless_hash<frozen::elsa<int>>>{2, a, 3, a}),
+                    std::invalid_argument);
+}
+
+TEST_CASE("frozen::unordered_set index_of", "[unordered_set]") {
+  // The items keep the order they were given in.
+  constexpr frozen::unordered_set<frozen::string, 3> unordered = {"Olaf", "Anna", "Elsa"};
+  static_assert(unordered.index_of("Olaf") == 0 && unordered.index_of("Elsa") == 2, "");
+  static_assert(unordered.index_of("Sven") == 3, "");
+}